@@ -0,0 +1,85 @@
+# Autotuner for ctl loop shapes.
+#
+# ctl_autotune(KERNEL <tag> SOURCE <file> OUTPUT <header>
+#              [FACTORS <factor>...] [MODES <inlined|outlined>...])
+#
+# Compiles and runs SOURCE once for every combination of unroll factor and expansion mode,
+# passing the candidate as CTL_AUTOTUNE_UNROLL and CTL_AUTOTUNE_MODE. SOURCE must print the time
+# of one run, in whole nanoseconds, on its standard output (see ctl::measure_ns). The fastest candidate is written to OUTPUT
+# as a specialization of ctl::tuning<tag>; every kernel tuned during a configure run goes into the same header.
+# Build the consumers with CTL_TUNING_HEADER="<header>" to use the results.
+# The tag must be a class declared at namespace scope, such as saxpy_kernel or app::saxpy_kernel;
+# the header forward-declares it in its namespace, so consumers need not declare it before including ctl/tuning.h.
+
+set(CTL_ROOT_DIR "${CMAKE_CURRENT_LIST_DIR}/.." CACHE INTERNAL "")
+
+function(ctl_autotune)
+    cmake_parse_arguments(ARG "" "KERNEL;SOURCE;OUTPUT" "FACTORS;MODES" ${ARGN})
+    if(NOT ARG_FACTORS)
+        set(ARG_FACTORS 1 2 4 8)
+    endif()
+    if(NOT ARG_MODES)
+        set(ARG_MODES inlined outlined)
+    endif()
+
+    # Candidates are measured with the optimization flags of a release build.
+    set(CMAKE_TRY_COMPILE_CONFIGURATION Release)
+    set(best_time "")
+    foreach(mode IN LISTS ARG_MODES)
+        foreach(factor IN LISTS ARG_FACTORS)
+            set(bin_dir "${CMAKE_BINARY_DIR}/ctl_autotune/${ARG_KERNEL}_${mode}_${factor}")
+            try_run(run_result compile_result "${bin_dir}" "${ARG_SOURCE}"
+                    CMAKE_FLAGS "-DINCLUDE_DIRECTORIES=${CTL_ROOT_DIR}"
+                    COMPILE_DEFINITIONS -DCTL_AUTOTUNE_UNROLL=${factor} -DCTL_AUTOTUNE_MODE=ctl::expansion_mode::${mode}
+                    CXX_STANDARD 17
+                    COMPILE_OUTPUT_VARIABLE compile_output
+                    RUN_OUTPUT_VARIABLE run_output)
+            if(NOT compile_result OR NOT run_result EQUAL 0)
+                message(WARNING "ctl_autotune: ${ARG_KERNEL} failed with ${mode} x${factor}\n${compile_output}")
+                continue()
+            endif()
+            string(REGEX MATCH "[0-9]+" time "${run_output}")
+            message(STATUS "ctl_autotune: ${ARG_KERNEL} ${mode} x${factor}: ${time} ns")
+            if(best_time STREQUAL "" OR time LESS best_time)
+                set(best_time ${time})
+                set(best_factor ${factor})
+                set(best_mode ${mode})
+            endif()
+        endforeach()
+    endforeach()
+
+    if(best_time STREQUAL "")
+        message(WARNING "ctl_autotune: no candidate ran for ${ARG_KERNEL}, keeping the defaults")
+        return()
+    endif()
+    message(STATUS "ctl_autotune: ${ARG_KERNEL} uses ${best_mode} x${best_factor}")
+
+    # A qualified tag is declared inside its namespace, since "struct app::tag;" at global scope is ill-formed.
+    string(REGEX REPLACE "^::" "" kernel "${ARG_KERNEL}")
+    string(FIND "${kernel}" "::" split REVERSE)
+    if(split EQUAL -1)
+        set(declaration "struct ${kernel};")
+    else()
+        string(SUBSTRING "${kernel}" 0 ${split} kernel_namespace)
+        math(EXPR name_start "${split} + 2")
+        string(SUBSTRING "${kernel}" ${name_start} -1 kernel_name)
+        set(declaration "namespace ${kernel_namespace}\n{\n    struct ${kernel_name};\n}")
+    endif()
+
+    get_property(entries GLOBAL PROPERTY CTL_AUTOTUNE_ENTRIES)
+    string(APPEND entries
+            "${declaration}\n\n"
+            "template<>\n"
+            "struct ctl::tuning<${ARG_KERNEL}>\n"
+            "{\n"
+            "    static constexpr std::size_t unroll_factor = ${best_factor};\n"
+            "    static constexpr ctl::expansion_mode mode = ctl::expansion_mode::${best_mode};\n"
+            "};\n\n")
+    set_property(GLOBAL PROPERTY CTL_AUTOTUNE_ENTRIES "${entries}")
+    file(WRITE "${ARG_OUTPUT}"
+            "// Generated by ctl_autotune, do not edit.\n"
+            "#ifndef CTL_GENERATED_TUNING_H\n"
+            "#define CTL_GENERATED_TUNING_H\n\n"
+            "${entries}"
+            "#endif //CTL_GENERATED_TUNING_H\n")
+endfunction()
@@ -0,0 +1,33 @@
+# Helper for ctl::sharded_for_loop.
+#
+# ctl_add_sharded_loop(<target> HEADER <header> LOOP <type> SHARDS <count>)
+#
+# Generates one translation unit per shard of the loop type LOOP (declared in HEADER, usually as an alias),
+# each explicitly instantiating its shard, and adds them to <target>. SHARDS must match the Shards argument of the type.
+# The shards compile in parallel, and a generated file is only rewritten when its content changes.
+
+set(CTL_ROOT_DIR "${CMAKE_CURRENT_LIST_DIR}/.." CACHE INTERNAL "")
+
+function(ctl_add_sharded_loop TARGET)
+    cmake_parse_arguments(ARG "" "HEADER;LOOP;SHARDS" "" ${ARGN})
+    string(MAKE_C_IDENTIFIER "${ARG_LOOP}" loop_name)
+    set(shard_dir "${CMAKE_CURRENT_BINARY_DIR}/ctl_shards/${loop_name}")
+    get_filename_component(header "${ARG_HEADER}" ABSOLUTE)
+
+    math(EXPR last "${ARG_SHARDS} - 1")
+    foreach(k RANGE 0 ${last})
+        string(CONFIGURE [=[
+// Generated by ctl_add_sharded_loop, do not edit.
+#include "@header@"
+#include "ctl/sharded_for_loop_impl.h"
+
+static_assert(@ARG_LOOP@::shard_count == @ARG_SHARDS@, "ctl_add_sharded_loop: SHARDS does not match the loop type");
+
+CTL_INSTANTIATE_SHARD(@k@, @ARG_LOOP@)
+]=] content @ONLY)
+        file(WRITE "${shard_dir}/shard_${k}.cpp.in" "${content}")
+        configure_file("${shard_dir}/shard_${k}.cpp.in" "${shard_dir}/shard_${k}.cpp" COPYONLY)
+        target_sources(${TARGET} PRIVATE "${shard_dir}/shard_${k}.cpp")
+    endforeach()
+    target_include_directories(${TARGET} PRIVATE "${CTL_ROOT_DIR}")
+endfunction()
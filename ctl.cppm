@@ -0,0 +1,51 @@
+// ctl - C++20 named module interface, used with `import ctl;`.
+//
+// The standard headers used by ctl are included in the global module fragment, so that only the declarations
+// of ctl itself are attached to the module and exported. Keep this list in sync with the includes of ctl/*.h.
+// Macros (CTL_NOINLINE, CTL_INSTANTIATE_SHARD, ...) cannot be exported, include the headers to use them.
+module;
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <ratio>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+export module ctl;
+
+// A specialization of a standard template cannot be exported, so ctl/iteration_space.h leaves it out of the export block
+// below and it is declared after it; importers still see it, since it is reachable through the module.
+#define CTL_MODULE_INTERFACE
+export
+{
+#include "ctl.h"
+}
+
+template<typename T, T I, T N, template<T> typename update_functor, template<T, T> typename conditional_functor>
+inline constexpr bool std::ranges::enable_borrowed_range<ctl::iteration_range<T, I, N, update_functor, conditional_functor>> = true;
@@ -0,0 +1,364 @@
+#ifndef CTL_BIG_INT_H
+#define CTL_BIG_INT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+/**
+ * big_int - Fixed-width unsigned integers usable in constant expressions.
+ */
+
+namespace ctl
+{
+    /**
+     * Unsigned integer of a fixed number of bits, with wrap-around arithmetic like the built-in unsigned types.
+     * All members are public, so the type is structural and can be a template argument from C++20 onwards.
+     *
+     * @tparam Bits                 The width of the integer, a multiple of 64.
+     */
+    template<std::size_t Bits>
+    struct big_int
+    {
+        static_assert(Bits > 0 && Bits % 64 == 0, "[ctl::big_int]: the width must be a positive multiple of 64");
+
+        using word_type = std::uint64_t;
+
+        static constexpr std::size_t word_bits = 64;
+        static constexpr std::size_t word_count = Bits / word_bits;
+
+        // The words of the integer, least significant first.
+        std::array<word_type, word_count> words{};
+
+        constexpr big_int() noexcept = default;
+
+        constexpr big_int(word_type value) noexcept : words{value}
+        {
+        }
+
+        constexpr explicit operator bool() const noexcept
+        {
+            for (word_type w : words)
+                if (w)
+                    return true;
+            return false;
+        }
+
+        constexpr explicit operator word_type() const noexcept
+        {
+            return words[0];
+        }
+
+        /**
+         * Method used to count the significant bits.
+         *
+         * @return                  The position of the highest set bit plus one, or 0 for zero.
+         */
+        constexpr std::size_t bit_width() const noexcept
+        {
+            for (std::size_t i = word_count; i-- > 0;)
+                if (words[i])
+                {
+                    std::size_t width = i * word_bits;
+                    for (word_type w = words[i]; w; w >>= 1)
+                        ++width;
+                    return width;
+                }
+            return 0;
+        }
+
+        constexpr big_int &operator+=(const big_int &other) noexcept
+        {
+            bool carry = false;
+            for (std::size_t i = 0; i < word_count; ++i)
+                carry = add_with_carry(words[i], other.words[i], carry, words[i]);
+            return *this;
+        }
+
+        constexpr big_int &operator-=(const big_int &other) noexcept
+        {
+            bool borrow = false;
+            for (std::size_t i = 0; i < word_count; ++i)
+                borrow = sub_with_borrow(words[i], other.words[i], borrow, words[i]);
+            return *this;
+        }
+
+        constexpr big_int &operator*=(const big_int &other) noexcept
+        {
+            big_int result;
+            for (std::size_t i = 0; i < word_count; ++i)
+            {
+                word_type carry = 0;
+                for (std::size_t j = 0; i + j < word_count; ++j)
+                {
+                    word_type high = 0;
+                    word_type low = mul_wide(words[i], other.words[j], high);
+                    high += add_with_carry(low, result.words[i + j], false, low);
+                    high += add_with_carry(low, carry, false, low);
+                    result.words[i + j] = low;
+                    carry = high;
+                }
+            }
+            return *this = result;
+        }
+
+        constexpr big_int &operator/=(const big_int &other) noexcept
+        {
+            return *this = divide(*this, other).quotient;
+        }
+
+        constexpr big_int &operator%=(const big_int &other) noexcept
+        {
+            return *this = divide(*this, other).remainder;
+        }
+
+        constexpr big_int &operator<<=(std::size_t shift) noexcept
+        {
+            if (shift >= Bits)
+                return *this = big_int{};
+            std::size_t word_shift = shift / word_bits, bit_shift = shift % word_bits;
+            for (std::size_t i = word_count; i-- > 0;)
+            {
+                word_type w = i >= word_shift ? words[i - word_shift] << bit_shift : 0;
+                if (bit_shift && i > word_shift)
+                    w |= words[i - word_shift - 1] >> (word_bits - bit_shift);
+                words[i] = w;
+            }
+            return *this;
+        }
+
+        constexpr big_int &operator>>=(std::size_t shift) noexcept
+        {
+            if (shift >= Bits)
+                return *this = big_int{};
+            std::size_t word_shift = shift / word_bits, bit_shift = shift % word_bits;
+            for (std::size_t i = 0; i < word_count; ++i)
+            {
+                word_type w = i + word_shift < word_count ? words[i + word_shift] >> bit_shift : 0;
+                if (bit_shift && i + word_shift + 1 < word_count)
+                    w |= words[i + word_shift + 1] << (word_bits - bit_shift);
+                words[i] = w;
+            }
+            return *this;
+        }
+
+        friend constexpr big_int operator+(big_int a, const big_int &b) noexcept
+        {
+            return a += b;
+        }
+
+        friend constexpr big_int operator-(big_int a, const big_int &b) noexcept
+        {
+            return a -= b;
+        }
+
+        friend constexpr big_int operator*(big_int a, const big_int &b) noexcept
+        {
+            return a *= b;
+        }
+
+        friend constexpr big_int operator/(big_int a, const big_int &b) noexcept
+        {
+            return a /= b;
+        }
+
+        friend constexpr big_int operator%(big_int a, const big_int &b) noexcept
+        {
+            return a %= b;
+        }
+
+        friend constexpr big_int operator<<(big_int a, std::size_t shift) noexcept
+        {
+            return a <<= shift;
+        }
+
+        friend constexpr big_int operator>>(big_int a, std::size_t shift) noexcept
+        {
+            return a >>= shift;
+        }
+
+        friend constexpr bool operator==(const big_int &a, const big_int &b) noexcept
+        {
+            for (std::size_t i = 0; i < word_count; ++i)
+                if (a.words[i] != b.words[i])
+                    return false;
+            return true;
+        }
+
+        friend constexpr bool operator!=(const big_int &a, const big_int &b) noexcept
+        {
+            return !(a == b);
+        }
+
+        friend constexpr bool operator<(const big_int &a, const big_int &b) noexcept
+        {
+            for (std::size_t i = word_count; i-- > 0;)
+                if (a.words[i] != b.words[i])
+                    return a.words[i] < b.words[i];
+            return false;
+        }
+
+        friend constexpr bool operator>(const big_int &a, const big_int &b) noexcept
+        {
+            return b < a;
+        }
+
+        friend constexpr bool operator<=(const big_int &a, const big_int &b) noexcept
+        {
+            return !(b < a);
+        }
+
+        friend constexpr bool operator>=(const big_int &a, const big_int &b) noexcept
+        {
+            return !(a < b);
+        }
+
+        struct division_result
+        {
+            big_int quotient;
+            big_int remainder;
+        };
+
+        /**
+         * Static method used to divide two integers.
+         * Divisors that fit in one word are handled word by word, any other divisor by shift-and-subtract.
+         * Division by zero yields a zero quotient and leaves the dividend as the remainder.
+         *
+         * @param a                 The dividend.
+         * @param b                 The divisor.
+         * @return                  The quotient and the remainder.
+         */
+        static constexpr division_result divide(const big_int &a, const big_int &b) noexcept
+        {
+            division_result result{};
+            if (!b)
+            {
+                result.remainder = a;
+                return result;
+            }
+            if (b.bit_width() <= word_bits)
+            {
+                word_type remainder = 0;
+                for (std::size_t i = word_count; i-- > 0;)
+                    result.quotient.words[i] = div_wide(remainder, a.words[i], b.words[0], remainder);
+                result.remainder = remainder;
+                return result;
+            }
+            for (std::size_t i = a.bit_width(); i-- > 0;)
+            {
+                result.remainder <<= 1;
+                result.remainder.words[0] |= (a.words[i / word_bits] >> (i % word_bits)) & 1;
+                if (result.remainder >= b)
+                {
+                    result.remainder -= b;
+                    result.quotient.words[i / word_bits] |= word_type{1} << (i % word_bits);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * The maximum number of decimal digits of the type (a bound on Bits * log10(2)).
+         */
+        static constexpr std::size_t max_digits = Bits * 30103 / 100000 + 1;
+
+        /**
+         * Method used to format the integer in base 10, usable in constant expressions.
+         *
+         * @return                  The null-terminated digits, without leading zeros.
+         */
+        constexpr std::array<char, max_digits + 1> to_chars() const noexcept
+        {
+            std::array<char, max_digits + 1> reversed{}, result{};
+            std::size_t length = 0;
+            big_int value = *this;
+            do
+            {
+                division_result step = divide(value, word_type{10});
+                reversed[length++] = static_cast<char>('0' + step.remainder.words[0]);
+                value = step.quotient;
+            } while (value);
+            for (std::size_t i = 0; i < length; ++i)
+                result[i] = reversed[length - 1 - i];
+            return result;
+        }
+
+        friend std::ostream &operator<<(std::ostream &os, const big_int &value)
+        {
+            return os << value.to_chars().data();
+        }
+
+    private:
+        static constexpr bool add_with_carry(word_type a, word_type b, bool carry, word_type &out) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            bool first = __builtin_add_overflow(a, b, &out);
+            bool second = __builtin_add_overflow(out, word_type{carry}, &out);
+            return first || second;
+#else
+            word_type sum = a + b;
+            bool first = sum < a;
+            out = sum + carry;
+            return first || out < sum;
+#endif
+        }
+
+        static constexpr bool sub_with_borrow(word_type a, word_type b, bool borrow, word_type &out) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            bool first = __builtin_sub_overflow(a, b, &out);
+            bool second = __builtin_sub_overflow(out, word_type{borrow}, &out);
+            return first || second;
+#else
+            word_type difference = a - b;
+            bool first = a < b;
+            out = difference - borrow;
+            return first || difference < word_type{borrow};
+#endif
+        }
+
+        // Returns the low word of a * b and stores the high word into high.
+        static constexpr word_type mul_wide(word_type a, word_type b, word_type &high) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            high = static_cast<word_type>(product >> 64);
+            return static_cast<word_type>(product);
+#else
+            word_type a_lo = a & 0xffffffff, a_hi = a >> 32, b_lo = b & 0xffffffff, b_hi = b >> 32;
+            word_type lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+            word_type middle = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+            high = hi_hi + (hi_lo >> 32) + (middle >> 32);
+            return (middle << 32) | (lo_lo & 0xffffffff);
+#endif
+        }
+
+        // Divides the two-word value (high, low) by divisor, with high < divisor.
+        static constexpr word_type div_wide(word_type high, word_type low, word_type divisor, word_type &remainder) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            unsigned __int128 dividend = (static_cast<unsigned __int128>(high) << 64) | low;
+            remainder = static_cast<word_type>(dividend % divisor);
+            return static_cast<word_type>(dividend / divisor);
+#else
+            word_type quotient = 0;
+            for (int bit = 63; bit >= 0; --bit)
+            {
+                bool overflow = high >> 63;
+                high = (high << 1) | ((low >> bit) & 1);
+                if (overflow || high >= divisor)
+                {
+                    high -= divisor;
+                    quotient |= word_type{1} << bit;
+                }
+            }
+            remainder = high;
+            return quotient;
+#endif
+        }
+    }; // struct big_int
+
+    using uint128 = big_int<128>;
+    using uint256 = big_int<256>;
+} // namespace ctl
+#endif //CTL_BIG_INT_H
@@ -0,0 +1,92 @@
+#ifndef CTL_BITSET_H
+#define CTL_BITSET_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+/**
+ * bitset - Packed bit tables generated at compile-time from a predicate functor.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct used to evaluate a predicate over [0, N) at compile-time and pack the results into words.
+     * The table is a constexpr array, so it ends up in read-only data and costs nothing at startup.
+     *
+     * @tparam N                    The number of bits in the table.
+     * @tparam predicate            A functor that returns the value of bit I.
+     */
+    template<std::size_t N, template<std::size_t> typename predicate>
+    struct make_bitset
+    {
+        make_bitset() = delete;
+
+        using word_type = std::uint64_t;
+
+        static constexpr std::size_t word_bits = 64;
+        static constexpr std::size_t word_count = (N + word_bits - 1) / word_bits;
+
+    private:
+        /**
+         * Helper static method used to compute a single bit of the table.
+         * The predicate is never instantiated for indices past N.
+         *
+         * @tparam I                The index of the bit.
+         */
+        template<std::size_t I>
+        static constexpr word_type bit() noexcept
+        {
+            if constexpr (I < N)
+                return predicate<I>{}() ? word_type{1} << (I % word_bits) : word_type{0};
+            else
+                return word_type{0};
+        }
+
+        template<std::size_t W, std::size_t ... Bits>
+        static constexpr word_type make_word(std::index_sequence<Bits ...>) noexcept
+        {
+            return (bit<W * word_bits + Bits>() | ... | word_type{0});
+        }
+
+        template<std::size_t ... Words>
+        static constexpr std::array<word_type, word_count> make_words(std::index_sequence<Words ...>) noexcept
+        {
+            return {make_word<Words>(std::make_index_sequence<word_bits>{}) ...};
+        }
+
+    public:
+        static constexpr std::array<word_type, word_count> words = make_words(std::make_index_sequence<word_count>{});
+
+        /**
+         * Static method used to read a bit of the table.
+         *
+         * @param i                 The index of the bit, must be less than N.
+         * @return                  The value of the predicate for i.
+         */
+        static constexpr bool test(std::size_t i) noexcept
+        {
+            return (words[i / word_bits] >> (i % word_bits)) & word_type{1};
+        }
+
+        /**
+         * Static method used to count the set bits.
+         *
+         * @return                  The number of indices for which the predicate holds.
+         */
+        static constexpr std::size_t count() noexcept
+        {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < N; ++i)
+                total += test(i);
+            return total;
+        }
+
+        static constexpr std::size_t size() noexcept
+        {
+            return N;
+        }
+    }; // struct make_bitset
+} // namespace ctl
+#endif //CTL_BITSET_H
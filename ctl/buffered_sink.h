@@ -0,0 +1,352 @@
+#ifndef CTL_BUFFERED_SINK_H
+#define CTL_BUFFERED_SINK_H
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "per_thread.h"
+/**
+ * buffered_sink - Output shared by several threads, buffered per thread and merged in a deterministic order.
+ */
+
+namespace ctl
+{
+    /**
+     * The order in which ctl::buffered_sink merges the output of its threads.
+     * key     - by the key each chunk was written under (e.g. the loop iteration), then by arrival.
+     * arrival - in the order in which the chunks were started.
+     */
+    enum class merge_order
+    {
+        key,
+        arrival
+    };
+
+    /**
+     * Output that keeps what each thread writes in a buffer of its own, without locks, until it is merged
+     * into the target stream. A std::ostream must not be used by several threads at once, since every formatted
+     * write updates its state, so each thread writes through a stream of its own, returned by stream(),
+     * or formats integers straight into its buffer with print() (see ctl::sink_output_functors):
+     *
+     *     ctl::buffered_sink sink(std::cout);
+     *     sink.stream() << "iteration " << i << '\n';
+     *
+     * The output is cut into chunks, each tagged with the key set by the writing thread and the time it was started.
+     * When the buffered output exceeds the memory budget, the writing thread spills its own chunks to the target
+     * under a lock; only the output that stays within the budget is merged in order.
+     *
+     * @tparam CharT                The character type of the target stream.
+     * @tparam Traits               The character traits of the target stream.
+     */
+    template<typename CharT, typename Traits = std::char_traits<CharT>>
+    struct basic_buffered_sink
+    {
+        using char_type = CharT;
+        using traits_type = Traits;
+        using stream_type = std::basic_ostream<CharT, Traits>;
+        using key_type = long long;
+
+        /**
+         * @param target            The stream that receives the merged output.
+         * @param budget            The number of characters that may be buffered over all threads before a thread spills.
+         *                          Each thread reports its output every budget / 64 characters, so the budget can be
+         *                          exceeded by that much per thread.
+         */
+        explicit basic_buffered_sink(stream_type &target, std::size_t budget = std::size_t{1} << 20)
+                : target(target), budget(budget), report_step(std::max<std::size_t>(budget / 64, 1))
+        {
+        }
+
+        basic_buffered_sink(const basic_buffered_sink &) = delete;
+        basic_buffered_sink &operator=(const basic_buffered_sink &) = delete;
+
+        ~basic_buffered_sink()
+        {
+            merge();
+        }
+
+        /**
+         * Method used to set the key of the output that the calling thread writes from now on.
+         *
+         * @param key               The key, usually the iteration that produces the output.
+         */
+        void set_key(key_type key)
+        {
+            local().key = key;
+        }
+
+        /**
+         * Sets the key of the calling thread for the lifetime of the object, then restores the previous one.
+         */
+        struct scoped_key
+        {
+            scoped_key(basic_buffered_sink &sink, key_type key) : buffer(sink.local()), previous(buffer.key)
+            {
+                buffer.key = key;
+            }
+
+            scoped_key(const scoped_key &) = delete;
+            scoped_key &operator=(const scoped_key &) = delete;
+
+            ~scoped_key()
+            {
+                buffer.key = previous;
+            }
+
+        private:
+            typename basic_buffered_sink::thread_buffer &buffer;
+            key_type previous;
+        }; // struct scoped_key
+
+        /**
+         * Method used to get the stream of the calling thread, which writes to the buffer of that thread.
+         * Its formatting state (width, precision, flags) belongs to the thread as well.
+         */
+        stream_type &stream()
+        {
+            return *local().stream;
+        }
+
+        /**
+         * Method used to write characters to the buffer of the calling thread.
+         *
+         * @param s                 Pointer to the first character.
+         * @param n                 The number of characters.
+         */
+        void write(const CharT *s, std::size_t n)
+        {
+            append(local(), s, n);
+        }
+
+        /**
+         * Method used to write a value to the buffer of the calling thread.
+         * Characters are written as they are, integers are formatted in decimal with std::to_chars,
+         * other values go through stream().
+         *
+         * @param value             The value to be written.
+         */
+        template<typename V>
+        void print(const V &value)
+        {
+            if constexpr (std::is_same_v<V, CharT> || std::is_same_v<V, char>)
+            {
+                CharT c = static_cast<CharT>(value);
+                write(&c, 1);
+            }
+            else if constexpr (std::is_integral_v<V> && !std::is_same_v<V, bool>)
+            {
+                char digits[24];
+                char *end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+                CharT text[sizeof(digits)];
+                std::copy(digits, end, text);
+                write(text, static_cast<std::size_t>(end - digits));
+            }
+            else
+                stream() << value;
+        }
+
+        /**
+         * Method used to write the buffered output of all threads to the target, and to clear the buffers.
+         * Must not run concurrently with threads writing to the sink.
+         *
+         * @param order             The order in which the chunks are written.
+         */
+        void merge(merge_order order = merge_order::key)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<std::pair<const thread_buffer *, const chunk *>> chunks;
+            buffers.for_each([&chunks](const thread_buffer &b)
+            {
+                for (const chunk &c : b.chunks)
+                    chunks.emplace_back(&b, &c);
+            });
+            // The chunks of a thread are gathered in the order it wrote them, the stable sort keeps that order on ties.
+            std::stable_sort(chunks.begin(), chunks.end(), [order](const auto &a, const auto &b)
+            {
+                if (order == merge_order::key && a.second->key != b.second->key)
+                    return a.second->key < b.second->key;
+                return a.second->started < b.second->started;
+            });
+            for (const auto &[b, c] : chunks)
+                target.write(b->data.data() + c->offset, static_cast<std::streamsize>(c->size));
+            target.flush();
+            buffers.for_each([](thread_buffer &b)
+            {
+                b.clear();
+            });
+            buffered_chars.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * Method used to get the number of characters currently buffered over all threads, as last reported by them.
+         */
+        std::size_t buffered() const noexcept
+        {
+            return buffered_chars.load(std::memory_order_relaxed);
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct chunk
+        {
+            key_type key;
+            clock::rep started;
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        // The stream of a thread writes through this buffer, which has no put area, so every write reaches the sink.
+        struct thread_buffer : std::basic_streambuf<CharT, Traits>
+        {
+            basic_buffered_sink *owner = nullptr;
+            // The buffer of an exited thread is handed to the next one, which gets a fresh key and stream.
+            std::thread::id thread;
+            key_type key = 0;
+            std::basic_string<CharT, Traits> data;
+            std::vector<chunk> chunks;
+            // The characters written since the thread last added to buffered_chars.
+            std::size_t unreported = 0;
+            std::optional<stream_type> stream;
+
+            void clear() noexcept
+            {
+                data.clear();
+                chunks.clear();
+                unreported = 0;
+            }
+
+        protected:
+            std::streamsize xsputn(const CharT *s, std::streamsize n) override
+            {
+                owner->append(*this, s, static_cast<std::size_t>(n));
+                return n;
+            }
+
+            typename Traits::int_type overflow(typename Traits::int_type c) override
+            {
+                if (Traits::eq_int_type(c, Traits::eof()))
+                    return Traits::not_eof(c);
+                CharT ch = Traits::to_char_type(c);
+                owner->append(*this, &ch, 1);
+                return c;
+            }
+
+            // std::flush and std::endl must not merge while other threads write, the output stays buffered until merge.
+            int sync() override
+            {
+                return 0;
+            }
+        };
+
+        stream_type &target;
+        const std::size_t budget;
+        const std::size_t report_step;
+        std::atomic<std::size_t> buffered_chars{0};
+        // Serializes the writes to the target, the buffers themselves are never shared.
+        std::mutex mutex;
+        per_thread_registry<thread_buffer> buffers;
+
+        thread_buffer &local()
+        {
+            thread_buffer &b = buffers.local();
+            if (b.thread != std::this_thread::get_id())
+            {
+                b.owner = this;
+                b.thread = std::this_thread::get_id();
+                b.key = 0;
+                b.stream.emplace(&b);
+            }
+            return b;
+        }
+
+        // Only a new chunk reads the clock, and only every report_step characters touch the shared counter.
+        void append(thread_buffer &b, const CharT *s, std::size_t n)
+        {
+            if (b.chunks.empty() || b.chunks.back().key != b.key)
+                b.chunks.push_back({b.key, clock::now().time_since_epoch().count(), b.data.size(), 0});
+            b.data.append(s, n);
+            b.chunks.back().size += n;
+            b.unreported += n;
+            if (b.unreported < report_step)
+                return;
+            std::size_t total = buffered_chars.fetch_add(b.unreported, std::memory_order_relaxed) + b.unreported;
+            b.unreported = 0;
+            if (total > budget)
+                spill(b);
+        }
+
+        void spill(thread_buffer &b)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            target.write(b.data.data(), static_cast<std::streamsize>(b.data.size()));
+            buffered_chars.fetch_sub(b.data.size(), std::memory_order_relaxed);
+            b.clear();
+        }
+    }; // struct basic_buffered_sink
+
+    using buffered_sink = basic_buffered_sink<char>;
+
+    /**
+     * Wrapper struct for output functors that print to a buffered_sink, like ctl::utils::output_functors.
+     * Each thread formats into its own buffer, so the functors can run on several threads at once.
+     *
+     * @tparam T                    The type used for the begin iterator.
+     * @tparam sink                 The sink the output goes to.
+     * @tparam sep                  The character that separates the output.
+     */
+    template<typename T, buffered_sink &sink, const char sep = ' '>
+    struct sink_output_functors
+    {
+        /**
+         * Prints the index received as a template parameter to the sink.
+         *
+         * @tparam I    The index to be printed.
+         */
+        template<T I>
+        struct print_index
+        {
+            void operator()() const
+            {
+                sink.print(I);
+                if constexpr (sep)
+                    sink.print(sep);
+            }
+        };
+    }; // struct sink_output_functors
+
+    /**
+     * Wraps the action functor of a ctl::for_loop so that its output to a buffered_sink is keyed by the iteration,
+     * which makes merge_order::key print the iterations in loop order whatever thread ran them.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam action_functor       The functor whose output is keyed.
+     * @tparam sink                 The sink the functor writes to.
+     */
+    template<typename T, template<T> typename action_functor, buffered_sink &sink>
+    struct keyed_output
+    {
+        template<T I>
+        struct instance
+        {
+            template<typename ... Params>
+            void operator()(Params & ... params) const
+            {
+                buffered_sink::scoped_key key(sink, static_cast<buffered_sink::key_type>(I));
+                action_functor<I>{}(params ...);
+            }
+        };
+    }; // struct keyed_output
+} // namespace ctl
+#endif //CTL_BUFFERED_SINK_H
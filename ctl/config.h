@@ -0,0 +1,44 @@
+#ifndef CTL_CONFIG_H
+#define CTL_CONFIG_H
+/**
+ * config - Compiler-specific macros and tunable limits used by ctl.
+ */
+
+// Prevents a function from being inlined into its callers.
+#if defined(_MSC_VER)
+#define CTL_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#define CTL_NOINLINE __attribute__((noinline))
+#else
+#define CTL_NOINLINE
+#endif
+
+// Forces a function to be inlined into its callers, even past the compiler's size limits.
+#if defined(_MSC_VER)
+#define CTL_FORCEINLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#define CTL_FORCEINLINE inline __attribute__((always_inline))
+#else
+#define CTL_FORCEINLINE inline
+#endif
+
+// Loops with more iterations than this are outlined by ctl::expansion_mode::automatic (which loops must opt in to).
+// tools/bench_expansion.cpp measures the trade-off: with actions of a few instructions the inlined expansion stays faster
+// even when it overflows the instruction cache, so automatic mainly bounds the code size of long loops. Inlined loops are
+// also limited by -ftemplate-depth (900 by default with GCC), outlined ones are not, so keep the threshold below it.
+#ifndef CTL_OUTLINE_THRESHOLD
+#define CTL_OUTLINE_THRESHOLD 256
+#endif
+
+// Define CTL_PROFILING to time the actions wrapped in ctl::profiled.
+// Iterations at positions past CTL_PROFILE_CAPACITY in their loop share the last slot.
+#ifndef CTL_PROFILE_CAPACITY
+#define CTL_PROFILE_CAPACITY 256
+#endif
+
+// ctl::fft fully unrolls transforms of up to CTL_FFT_UNROLL_LIMIT points; larger ones loop over each stage's butterflies.
+// Past 64 points the unrolled code runs slower than the loops (it no longer fits the instruction cache) and takes seconds to compile.
+#ifndef CTL_FFT_UNROLL_LIMIT
+#define CTL_FFT_UNROLL_LIMIT 64
+#endif
+#endif //CTL_CONFIG_H
@@ -0,0 +1,133 @@
+#ifndef CTL_CRC_H
+#define CTL_CRC_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "functors.h"
+#include "loops.h"
+/**
+ * crc - CRC lookup tables generated at compile-time and slice-by-N kernels unrolled with ctl::for_loop.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct holding the lookup tables of a reflected (LSB-first) CRC.
+     * Table 0 is the classic byte-at-a-time table, table k advances a byte through k further zero bytes.
+     *
+     * @tparam T                    The unsigned type of the CRC register.
+     * @tparam Poly                 The reflected generator polynomial.
+     * @tparam Slices               The number of tables (the bytes consumed per step of the kernel).
+     */
+    template<typename T, T Poly, std::size_t Slices = 1>
+    struct crc_table
+    {
+        static_assert(std::is_unsigned_v<T>, "[ctl::crc_table]: the CRC register must be an unsigned type");
+        static_assert(Slices > 0, "[ctl::crc_table]: at least one table is required");
+
+        crc_table() = delete;
+
+    private:
+        static constexpr std::array<std::array<T, 256>, Slices> make() noexcept
+        {
+            std::array<std::array<T, 256>, Slices> result{};
+            for (std::size_t i = 0; i < 256; ++i)
+            {
+                T crc = static_cast<T>(i);
+                for (int bit = 0; bit < 8; ++bit)
+                    crc = (crc & 1) ? static_cast<T>((crc >> 1) ^ Poly) : static_cast<T>(crc >> 1);
+                result[0][i] = crc;
+            }
+            for (std::size_t k = 1; k < Slices; ++k)
+                for (std::size_t i = 0; i < 256; ++i)
+                    result[k][i] = static_cast<T>((result[k - 1][i] >> 8) ^ result[0][result[k - 1][i] & 0xff]);
+            return result;
+        }
+
+    public:
+        static constexpr std::array<std::array<T, 256>, Slices> value = make();
+    }; // struct crc_table
+
+    /**
+     * Struct used to compute a reflected CRC with a slice-by-N kernel.
+     *
+     * @tparam T                    The unsigned type of the CRC register.
+     * @tparam Poly                 The reflected generator polynomial.
+     * @tparam Init                 The initial value of the register.
+     * @tparam XorOut               The value xor-ed into the register to produce the result.
+     * @tparam Slices               The number of bytes consumed per step of the kernel.
+     */
+    template<typename T, T Poly, T Init, T XorOut, std::size_t Slices = 8>
+    struct crc
+    {
+        crc() = delete;
+
+        using table = crc_table<T, Poly, Slices>;
+
+    private:
+        /**
+         * Helper functor for the J-th byte of a step: looks the byte up in the table that advances it past the rest of the step.
+         *
+         * @tparam J                The position of the byte in the step.
+         */
+        template<std::size_t J>
+        struct slice_step
+        {
+            void operator()(T &next, const T &state, const unsigned char *&data) const noexcept
+            {
+                unsigned char byte = data[J];
+                if constexpr (J < sizeof(T))
+                    byte ^= static_cast<unsigned char>(state >> (8 * J));
+                next ^= table::value[Slices - 1 - J][byte];
+            }
+        };
+
+    public:
+        /**
+         * Static method used to feed bytes into the CRC register.
+         *
+         * @param state             The current value of the register (Init for a new message).
+         * @param data              Pointer to the first byte.
+         * @param n                 The number of bytes.
+         * @return                  The new value of the register.
+         */
+        static T update(T state, const void *data, std::size_t n) noexcept
+        {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            for (; n >= Slices; n -= Slices, bytes += Slices)
+            {
+                T next = 0;
+                if constexpr (Slices < sizeof(T))
+                    next = static_cast<T>(state >> (8 * Slices));
+                for_loop<std::size_t, 0, Slices,
+                        functors<std::size_t>::update_functors<1>::inc,
+                        functors<std::size_t>::less_than,
+                        slice_step,
+                        expansion_mode::inlined>::begin(next, state, bytes);
+                state = next;
+            }
+            for (; n > 0; --n, ++bytes)
+                state = static_cast<T>((state >> 8) ^ table::value[0][(state ^ *bytes) & 0xff]);
+            return state;
+        }
+
+        /**
+         * Static method used to compute the CRC of a whole message.
+         *
+         * @param data              Pointer to the first byte.
+         * @param n                 The number of bytes.
+         * @return                  The CRC of the message.
+         */
+        static T compute(const void *data, std::size_t n) noexcept
+        {
+            return static_cast<T>(update(Init, data, n) ^ XorOut);
+        }
+    }; // struct crc
+
+    using crc32 = crc<std::uint32_t, 0xEDB88320u, 0xFFFFFFFFu, 0xFFFFFFFFu>;
+    using crc32c = crc<std::uint32_t, 0x82F63B78u, 0xFFFFFFFFu, 0xFFFFFFFFu>;
+    using crc64 = crc<std::uint64_t, 0xC96C5795D7870F42ull, ~0ull, ~0ull>;
+} // namespace ctl
+#endif //CTL_CRC_H
@@ -0,0 +1,252 @@
+#ifndef CTL_ENUM_H
+#define CTL_ENUM_H
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include "functors.h"
+#include "loops.h"
+/**
+ * enum - Loops over the values of an enum, and name tables built at compile-time from the compiler's function signatures.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct used to perform an action for each value of an enum in [First, Last].
+     * The loop is a ctl::for_loop over the underlying type, widened so that Last may be its largest value.
+     *
+     * @tparam E                    The enum type.
+     * @tparam First                The first value visited by the loop.
+     * @tparam Last                 The last value visited by the loop.
+     */
+    template<typename E, E First, E Last>
+    struct for_each_enum
+    {
+        static_assert(std::is_enum_v<E>, "[ctl::for_each_enum]: E must be an enum type");
+
+        for_each_enum() = delete;
+
+        using underlying_type = std::underlying_type_t<E>;
+        using iterator_type = std::conditional_t<std::is_signed_v<underlying_type>, long long, unsigned long long>;
+
+        static_assert(static_cast<underlying_type>(First) <= static_cast<underlying_type>(Last),
+                      "[ctl::for_each_enum]: First must not be greater than Last");
+
+        static constexpr iterator_type first = static_cast<underlying_type>(First);
+        static constexpr iterator_type last = static_cast<underlying_type>(Last);
+
+        /**
+         * Static method used to start the loop.
+         * Any arguments are passed (as lvalues) to the action functor on each iteration.
+         *
+         * @tparam action_functor   A functor that performs the action for each enum value.
+         * @param params            Arguments forwarded to every call of the action functor.
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<template<E> typename action_functor, typename ... Params>
+        static constexpr bool begin(Params && ... params) noexcept
+        {
+            return for_loop<iterator_type, first, last + 1,
+                    functors<iterator_type>::template update_functors<1>::template inc,
+                    functors<iterator_type>::template less_than,
+                    adapter<action_functor>::template action>::begin(params ...);
+        }
+
+    private:
+        /**
+         * Helper struct that converts the iterator back to the enum before calling the action functor.
+         */
+        template<template<E> typename action_functor>
+        struct adapter
+        {
+            template<iterator_type I>
+            struct action
+            {
+                template<typename ... Params>
+                constexpr void operator()(Params & ... params) const noexcept
+                {
+                    action_functor<static_cast<E>(I)>{}(params ...);
+                }
+            };
+        };
+    }; // struct for_each_enum
+
+    /**
+     * Helper function whose signature, as printed by the compiler, spells out the enum value.
+     */
+    template<typename E, E V>
+    constexpr std::string_view enum_signature() noexcept
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return __FUNCSIG__;
+#else
+        return __PRETTY_FUNCTION__;
+#endif
+    }
+
+    /**
+     * Struct used to get the name of an enum value, as spelled in its declaration.
+     * The name is extracted from the signature of enum_signature<E, V>, values without an enumerator give an empty name.
+     *
+     * @tparam E                    The enum type.
+     * @tparam V                    The enum value.
+     */
+    template<typename E, E V>
+    struct enum_name
+    {
+        enum_name() = delete;
+
+    private:
+        static constexpr std::string_view parse() noexcept
+        {
+            std::string_view signature = enum_signature<E, V>();
+#if defined(_MSC_VER) && !defined(__clang__)
+            // ... enum_signature<enum E,E::V>(void) noexcept
+            signature = signature.substr(0, signature.rfind(">("));
+            signature = signature.substr(signature.rfind(',') + 1);
+#else
+            // ... enum_signature() [with E = E; E V = E::V; ...] (GCC) or [E = E, V = E::V] (Clang)
+            signature = signature.substr(signature.find("V = ") + 4);
+            signature = signature.substr(0, signature.find_first_of(";,]"));
+#endif
+            // Values without an enumerator are printed as casts, (E)5 or (E)(5).
+            if (signature.empty() || signature.front() == '(' || (signature.front() >= '0' && signature.front() <= '9') ||
+                signature.front() == '-')
+                return {};
+            std::size_t scope = signature.rfind(':');
+            return scope == std::string_view::npos ? signature : signature.substr(scope + 1);
+        }
+
+        static constexpr std::string_view view = parse();
+
+        // The name is copied out of the signature, so only the names end up in the binary.
+        static constexpr std::array<char, view.size() + 1> chars = []
+        {
+            std::array<char, view.size() + 1> result{};
+            for (std::size_t i = 0; i < view.size(); ++i)
+                result[i] = view[i];
+            return result;
+        }();
+
+    public:
+        static constexpr std::string_view value{chars.data(), view.size()};
+    }; // struct enum_name
+
+    template<typename E, E V>
+    inline constexpr std::string_view enum_name_v = enum_name<E, V>::value;
+
+    /**
+     * Struct holding the name tables of the enum values in [First, Last].
+     * Converting a value to its name is an array load; parsing a name is a binary search over the names, sorted at compile-time.
+     *
+     * @tparam E                    The enum type.
+     * @tparam First                The first value of the table.
+     * @tparam Last                 The last value of the table.
+     */
+    template<typename E, E First, E Last>
+    struct enum_names
+    {
+        static_assert(std::is_enum_v<E>, "[ctl::enum_names]: E must be an enum type");
+
+        enum_names() = delete;
+
+        using underlying_type = std::underlying_type_t<E>;
+        using loop = for_each_enum<E, First, Last>;
+
+        /**
+         * The number of values in [First, Last].
+         */
+        static constexpr std::size_t size = static_cast<std::size_t>(loop::last - loop::first) + 1;
+
+    private:
+        template<std::size_t ... Is>
+        static constexpr std::array<std::string_view, size> make_names(std::index_sequence<Is ...>) noexcept
+        {
+            return {enum_name_v<E, static_cast<E>(loop::first + static_cast<typename loop::iterator_type>(Is))> ...};
+        }
+
+    public:
+        /**
+         * The names indexed by value - First, empty for values without an enumerator.
+         */
+        static constexpr std::array<std::string_view, size> names = make_names(std::make_index_sequence<size>{});
+
+        /**
+         * The number of values in [First, Last] that have an enumerator.
+         */
+        static constexpr std::size_t named_count = []
+        {
+            std::size_t count = 0;
+            for (std::string_view name : names)
+                count += !name.empty();
+            return count;
+        }();
+
+        struct entry
+        {
+            std::string_view name;
+            E value;
+        };
+
+        /**
+         * The named values, sorted by name.
+         */
+        static constexpr std::array<entry, named_count> sorted = []
+        {
+            std::array<entry, named_count> result{};
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                if (names[i].empty())
+                    continue;
+                // Insertion sort, std::sort is not constexpr before C++20.
+                entry current{names[i], static_cast<E>(loop::first + static_cast<typename loop::iterator_type>(i))};
+                std::size_t j = count++;
+                for (; j > 0 && current.name < result[j - 1].name; --j)
+                    result[j] = result[j - 1];
+                result[j] = current;
+            }
+            return result;
+        }();
+
+        /**
+         * Static method used to get the name of a value.
+         *
+         * @param value             The enum value.
+         * @return                  The name of the enumerator, or an empty string_view for values outside the table or without one.
+         */
+        static constexpr std::string_view name(E value) noexcept
+        {
+            auto v = static_cast<typename loop::iterator_type>(static_cast<underlying_type>(value));
+            if (v < loop::first || v > loop::last)
+                return {};
+            return names[static_cast<std::size_t>(v - loop::first)];
+        }
+
+        /**
+         * Static method used to find the value of an enumerator from its name.
+         *
+         * @param name              The unqualified name of the enumerator.
+         * @return                  The value, or an empty optional if no enumerator in the table has that name.
+         */
+        static constexpr std::optional<E> parse(std::string_view name) noexcept
+        {
+            std::size_t lo = 0, hi = named_count;
+            while (lo < hi)
+            {
+                std::size_t mid = lo + (hi - lo) / 2;
+                if (sorted[mid].name < name)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            if (lo < named_count && sorted[lo].name == name)
+                return sorted[lo].value;
+            return std::nullopt;
+        }
+    }; // struct enum_names
+} // namespace ctl
+#endif //CTL_ENUM_H
@@ -0,0 +1,365 @@
+#ifndef CTL_FFT_H
+#define CTL_FFT_H
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include "config.h"
+#include "loops.h"
+#include "math_table.h"
+/**
+ * fft - Fixed-size fast Fourier transforms, with the butterfly network unrolled at compile-time.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct used to compute decimation-in-time FFTs of N points with radix-4 butterflies,
+     * preceded by one radix-2 stage when log2(N) is odd.
+     * The bit-reversal permutation and the twiddle factors are computed at compile-time.
+     * Up to CTL_FFT_UNROLL_LIMIT points every butterfly is expanded with its indices and twiddle factors as constants;
+     * the generated code grows as N log N, so larger sizes run the butterflies of each stage in a loop instead.
+     *
+     * @tparam N                    The number of points, a power of two.
+     * @tparam T                    The floating-point type of the real and imaginary parts.
+     */
+    template<std::size_t N, typename T = double>
+    struct fft
+    {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "[ctl::fft]: the size must be a power of two, at least 2");
+
+        fft() = delete;
+
+        using value_type = std::complex<T>;
+
+        static constexpr std::size_t size = N;
+
+        /**
+         * Whether the permutation and the butterflies are fully unrolled, true up to CTL_FFT_UNROLL_LIMIT points.
+         */
+        static constexpr bool unrolled = N <= CTL_FFT_UNROLL_LIMIT;
+
+        /**
+         * The number of radix-2 stages, log2(N).
+         */
+        static constexpr std::size_t stage_count = []
+        {
+            std::size_t result = 0;
+            while ((std::size_t{1} << result) < N)
+                ++result;
+            return result;
+        }();
+
+        /**
+         * The bit-reversal permutation, bit_reverse[i] is i with its stage_count low bits reversed.
+         */
+        static constexpr std::array<std::size_t, N> bit_reverse = []
+        {
+            std::array<std::size_t, N> result{};
+            for (std::size_t i = 0; i < N; ++i)
+                for (std::size_t b = 0; b < stage_count; ++b)
+                    result[i] |= ((i >> b) & 1) << (stage_count - 1 - b);
+            return result;
+        }();
+
+        /**
+         * The twiddle factors of the forward transform, exp(-2 * pi * i * k / N) for k in [0, N / 2).
+         * They are evaluated in double precision with ctl::math, then converted to T.
+         */
+        static constexpr std::array<T, N / 2> twiddle_re = []
+        {
+            std::array<T, N / 2> result{};
+            for (std::size_t k = 0; k < N / 2; ++k)
+                result[k] = static_cast<T>(math::cos{}(2 * math::pi * static_cast<double>(k) / N));
+            return result;
+        }();
+
+        static constexpr std::array<T, N / 2> twiddle_im = []
+        {
+            std::array<T, N / 2> result{};
+            for (std::size_t k = 0; k < N / 2; ++k)
+                result[k] = static_cast<T>(-math::sin{}(2 * math::pi * static_cast<double>(k) / N));
+            return result;
+        }();
+
+        /**
+         * Static method used to compute the forward transform in place.
+         *
+         * @param data              Pointer to the N points, overwritten by the transform.
+         */
+        static void forward(value_type *data) noexcept
+        {
+            permute(data);
+            run_stages<false>(data);
+        }
+
+        /**
+         * Static method used to compute the forward transform into another buffer.
+         * The bit-reversal permutation is done while copying, so the input is read only once.
+         *
+         * @param in                Pointer to the N input points.
+         * @param out               Pointer to where the N transformed points are written, must not overlap in.
+         */
+        static void forward(const value_type *in, value_type *out) noexcept
+        {
+            permute(in, out);
+            run_stages<false>(out);
+        }
+
+        /**
+         * Static method used to compute the inverse transform in place, scaled by 1 / N so that it undoes forward.
+         *
+         * @param data              Pointer to the N points, overwritten by the transform.
+         */
+        static void inverse(value_type *data) noexcept
+        {
+            permute(data);
+            run_stages<true>(data);
+            scale_all(data);
+        }
+
+        /**
+         * Static method used to compute the inverse transform into another buffer, scaled by 1 / N.
+         *
+         * @param in                Pointer to the N input points.
+         * @param out               Pointer to where the N transformed points are written, must not overlap in.
+         */
+        static void inverse(const value_type *in, value_type *out) noexcept
+        {
+            permute(in, out);
+            run_stages<true>(out);
+            scale_all(out);
+        }
+
+    private:
+        /**
+         * The twiddle factor exp(-2 * pi * i * k / N) for k in [0, N), conjugated for the inverse transform.
+         * Indices past N / 2 are the negated factors of k - N / 2.
+         */
+        static constexpr T twiddle_real(std::size_t k) noexcept
+        {
+            return k < N / 2 ? twiddle_re[k] : -twiddle_re[k - N / 2];
+        }
+
+        template<bool Inverse>
+        static constexpr T twiddle_imag(std::size_t k) noexcept
+        {
+            T im = k < N / 2 ? twiddle_im[k] : -twiddle_im[k - N / 2];
+            return Inverse ? -im : im;
+        }
+
+        /**
+         * Multiplies a point by the twiddle factor K.
+         * The products are written out, since std::complex multiplication checks for NaNs,
+         * and the multiplications by 1, -1 and +-i are left out.
+         */
+        template<bool Inverse, std::size_t K>
+        CTL_FORCEINLINE static value_type rotate(value_type a) noexcept
+        {
+            if constexpr (K == 0)
+                return a;
+            else if constexpr (2 * K == N)
+                return -a;
+            else if constexpr (4 * K == N || 4 * K == 3 * N)
+                return times_i<(4 * K == N) == Inverse>(a);
+            else
+            {
+                constexpr T wr = twiddle_real(K);
+                constexpr T wi = twiddle_imag<Inverse>(K);
+                return value_type(a.real() * wr - a.imag() * wi, a.real() * wi + a.imag() * wr);
+            }
+        }
+
+        /**
+         * All N twiddle factors of the forward transform, read by the looped stages without testing the index.
+         */
+        static constexpr std::array<T, N> circle_re = []
+        {
+            std::array<T, N> result{};
+            for (std::size_t k = 0; k < N; ++k)
+                result[k] = twiddle_real(k);
+            return result;
+        }();
+
+        static constexpr std::array<T, N> circle_im = []
+        {
+            std::array<T, N> result{};
+            for (std::size_t k = 0; k < N; ++k)
+                result[k] = twiddle_imag<false>(k);
+            return result;
+        }();
+
+        template<bool Inverse>
+        CTL_FORCEINLINE static value_type rotate(value_type a, std::size_t k) noexcept
+        {
+            T wr = circle_re[k];
+            T wi = Inverse ? -circle_im[k] : circle_im[k];
+            return value_type(a.real() * wr - a.imag() * wi, a.real() * wi + a.imag() * wr);
+        }
+
+        /**
+         * Multiplies a point by i, or by -i when Positive is false.
+         */
+        template<bool Positive>
+        CTL_FORCEINLINE static value_type times_i(value_type a) noexcept
+        {
+            return Positive ? value_type(-a.imag(), a.real()) : value_type(a.imag(), -a.real());
+        }
+
+        /**
+         * Radix-4 butterfly combining four sub-transforms of Q points into one of 4 * Q points.
+         * After the bit-reversal permutation, the sub-transforms of the inputs with residues 0, 2, 1 and 3 (mod 4)
+         * lie Q apart starting at p0, so the twiddled points are passed in that order.
+         */
+        template<bool Inverse>
+        CTL_FORCEINLINE static void radix4(value_type *data, std::size_t p0, std::size_t q,
+                                           value_type t0, value_type t1, value_type t2, value_type t3) noexcept
+        {
+            value_type s0 = t0 + t2, s1 = t0 - t2, s2 = t1 + t3;
+            value_type s3 = times_i<Inverse>(t1 - t3);
+            data[p0] = s0 + s2;
+            data[p0 + q] = s1 + s3;
+            data[p0 + 2 * q] = s0 - s2;
+            data[p0 + 3 * q] = s1 - s3;
+        }
+
+        template<std::size_t I>
+        struct swap_reversed
+        {
+            void operator()(value_type *data) const noexcept
+            {
+                if constexpr (I < bit_reverse[I])
+                    std::swap(data[I], data[bit_reverse[I]]);
+            }
+        };
+
+        template<std::size_t I>
+        struct copy_reversed
+        {
+            void operator()(const value_type *in, value_type *out) const noexcept
+            {
+                out[bit_reverse[I]] = in[I];
+            }
+        };
+
+        template<std::size_t I>
+        struct scale
+        {
+            void operator()(value_type *data) const noexcept
+            {
+                data[I] = value_type(data[I].real() / N, data[I].imag() / N);
+            }
+        };
+
+        /**
+         * Radix-2 butterfly B of the first stage, which has no twiddle factors.
+         */
+        template<std::size_t B>
+        struct radix2
+        {
+            void operator()(value_type *data) const noexcept
+            {
+                value_type a = data[2 * B], b = data[2 * B + 1];
+                data[2 * B] = a + b;
+                data[2 * B + 1] = a - b;
+            }
+        };
+
+        static void permute(value_type *data) noexcept
+        {
+            if constexpr (unrolled)
+                for_each_in<std::make_index_sequence<N>>::template begin<swap_reversed>(data);
+            else
+                for (std::size_t i = 0; i < N; ++i)
+                    if (i < bit_reverse[i])
+                        std::swap(data[i], data[bit_reverse[i]]);
+        }
+
+        static void permute(const value_type *in, value_type *out) noexcept
+        {
+            if constexpr (unrolled)
+                for_each_in<std::make_index_sequence<N>>::template begin<copy_reversed>(in, out);
+            else
+                for (std::size_t i = 0; i < N; ++i)
+                    out[bit_reverse[i]] = in[i];
+        }
+
+        static void scale_all(value_type *data) noexcept
+        {
+            if constexpr (unrolled)
+                for_each_in<std::make_index_sequence<N>>::template begin<scale>(data);
+            else
+                for (std::size_t i = 0; i < N; ++i)
+                    data[i] = value_type(data[i].real() / N, data[i].imag() / N);
+        }
+
+        template<bool Inverse>
+        static void run_stages(value_type *data) noexcept
+        {
+            if constexpr (stage_count % 2 == 1)
+            {
+                if constexpr (unrolled)
+                    for_each_in<std::make_index_sequence<N / 2>>::template begin<radix2>(data);
+                else
+                    for (std::size_t b = 0; b < N / 2; ++b)
+                        radix2<0>{}(data + 2 * b);
+            }
+            for_each_in<std::make_index_sequence<stage_count / 2>>::template begin<stage<Inverse>::template action>(data);
+        }
+
+        /**
+         * Helper struct holding the radix-4 stages.
+         *
+         * @tparam Inverse          Whether the conjugated twiddle factors of the inverse transform are used.
+         */
+        template<bool Inverse>
+        struct stage
+        {
+            /**
+             * Butterfly B of radix-4 stage R, combining four points Q apart.
+             */
+            template<std::size_t R, std::size_t B>
+            struct butterfly
+            {
+                static constexpr std::size_t q = std::size_t{1} << (stage_count % 2 + 2 * R);
+                static constexpr std::size_t p0 = (B / q) * 4 * q + B % q;
+                static constexpr std::size_t k = (B % q) * (N / (4 * q));
+
+                void operator()(value_type *data) const noexcept
+                {
+                    radix4<Inverse>(data, p0, q, data[p0],
+                                    rotate<Inverse, k>(data[p0 + 2 * q]),
+                                    rotate<Inverse, 2 * k>(data[p0 + q]),
+                                    rotate<Inverse, 3 * k>(data[p0 + 3 * q]));
+                }
+            };
+
+            template<std::size_t R>
+            struct action
+            {
+                template<std::size_t B>
+                using step = butterfly<R, B>;
+
+                static constexpr std::size_t q = step<0>::q;
+
+                void operator()(value_type *data) const noexcept
+                {
+                    if constexpr (unrolled)
+                        for_each_in<std::make_index_sequence<N / 4>>::template begin<step>(data);
+                    else
+                        for (std::size_t base = 0; base < N; base += 4 * q)
+                            for (std::size_t j = 0; j < q; ++j)
+                            {
+                                std::size_t p0 = base + j, k = j * (N / (4 * q));
+                                radix4<Inverse>(data, p0, q, data[p0],
+                                                rotate<Inverse>(data[p0 + 2 * q], k),
+                                                rotate<Inverse>(data[p0 + q], 2 * k),
+                                                rotate<Inverse>(data[p0 + 3 * q], 3 * k));
+                            }
+                }
+            };
+        }; // struct stage
+    }; // struct fft
+} // namespace ctl
+#endif //CTL_FFT_H
@@ -0,0 +1,102 @@
+#ifndef CTL_FUNCTORS_H
+#define CTL_FUNCTORS_H
+/**
+ * functors - Commonly used update and conditional functors for the ctl API. Does not depend on <iostream>.
+ */
+
+namespace ctl
+{
+    /**
+     * Wrapper struct containing helper functors.
+     *
+     * @tparam T        The type used for the begin iterator.
+     */
+    template<typename T>
+    struct functors
+    {
+        /**
+         * Wrapper struct for functors that update the iterator.
+         *
+         * @tparam delta    The amount by which the iterator is changed.
+         */
+        template<T delta>
+        struct update_functors
+        {
+            template<T I>
+            struct inc
+            {
+                constexpr T operator()() const noexcept
+                {
+                    return I + delta;
+                }
+            };
+
+            template<T I>
+            struct dec
+            {
+                constexpr T operator()() const noexcept
+                {
+                    return I - delta;
+                }
+            };
+
+            template<T I>
+            struct mul
+            {
+                constexpr T operator()() const noexcept
+                {
+                    return I * delta;
+                }
+            };
+
+            template<T I>
+            struct div
+            {
+                constexpr T operator()() const noexcept
+                {
+                    static_assert(delta != 0, "[ctl::functors::update_functors::div]: cannot divide by 0");
+                    return I / delta;
+                }
+            };
+        }; // struct update_functors
+
+        // Conditional functors to test the loop condition.
+
+        template<T I, T N>
+        struct less_than
+        {
+            constexpr bool operator()() const noexcept
+            {
+                return I < N;
+            }
+        };
+
+        template<T I, T N>
+        struct greater_than
+        {
+            constexpr bool operator()() const noexcept
+            {
+                return I > N;
+            }
+        };
+
+        template<T I, T N>
+        struct equ
+        {
+            constexpr bool operator()() const noexcept
+            {
+                return I == N;
+            }
+        };
+
+        template<T I, T N>
+        struct not_equ
+        {
+            constexpr bool operator()() const noexcept
+            {
+                return I != N;
+            }
+        };
+    }; // struct functors
+} // namespace ctl
+#endif //CTL_FUNCTORS_H
@@ -0,0 +1,190 @@
+#ifndef CTL_HISTOGRAM_H
+#define CTL_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "functors.h"
+#include "iteration_space.h"
+#include "per_thread.h"
+/**
+ * histogram - Log-linear histograms with a bucket layout fixed at compile-time and lock-free per-thread recording.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct used to count samples in log-linear buckets.
+     * [0, Min) is split into SubBuckets equal buckets, then every range [Min * 2^k, Min * 2^(k + 1)) below Max is split
+     * into SubBuckets equal buckets, so the relative error of a bucket is at most 1 / SubBuckets.
+     * Samples at or above the last bound are counted in the last bucket.
+     * The bucket of a sample is computed from its leading zero count, and each thread counts into its own storage.
+     *
+     * @tparam Min                  The end of the linear range, a power of two.
+     * @tparam Max                  The value the buckets must reach.
+     * @tparam SubBuckets           The number of buckets per power of two, a power of two not greater than Min.
+     */
+    template<std::uint64_t Min, std::uint64_t Max, std::size_t SubBuckets = 16>
+    struct histogram
+    {
+        static_assert(Min > 0 && (Min & (Min - 1)) == 0, "[ctl::histogram]: Min must be a power of two");
+        static_assert(SubBuckets > 0 && (SubBuckets & (SubBuckets - 1)) == 0 && SubBuckets <= Min,
+                      "[ctl::histogram]: SubBuckets must be a power of two not greater than Min");
+        static_assert(Min < Max && Max <= (std::uint64_t{1} << 63), "[ctl::histogram]: the range must satisfy Min < Max <= 2^63");
+
+        /**
+         * The starts of the power of two ranges, Min, 2 * Min, ... below Max.
+         */
+        using octaves = iteration_space<std::uint64_t, Min, Max,
+                functors<std::uint64_t>::template update_functors<2>::template mul,
+                functors<std::uint64_t>::template less_than>;
+
+        static constexpr std::size_t bucket_count = SubBuckets * (octaves::size + 1);
+
+        /**
+         * The lower bound of each bucket, followed by the upper bound of the last one.
+         */
+        static constexpr std::array<std::uint64_t, bucket_count + 1> bounds = []
+        {
+            std::array<std::uint64_t, bucket_count + 1> result{};
+            for (std::size_t s = 0; s < SubBuckets; ++s)
+                result[s] = Min / SubBuckets * s;
+            for (std::size_t k = 0; k < octaves::size; ++k)
+                for (std::size_t s = 0; s < SubBuckets; ++s)
+                    result[SubBuckets * (k + 1) + s] = octaves::values[k] + octaves::values[k] / SubBuckets * s;
+            result[bucket_count] = octaves::values[octaves::size - 1] * 2;
+            return result;
+        }();
+
+        /**
+         * Static method used to find the bucket of a value, without branches.
+         *
+         * @param value             The value.
+         * @return                  The index of the bucket that counts the value.
+         */
+        static constexpr std::size_t bucket_of(std::uint64_t value) noexcept
+        {
+            // Values below Min are handled as the octave of Min, told apart by the (value >= Min) term.
+            std::size_t msb = log2(value | Min);
+            std::size_t octave = msb - min_bits + (value >= Min);
+            std::size_t sub = (value >> (msb - sub_bits)) & (SubBuckets - 1);
+            std::size_t index = octave * SubBuckets + sub;
+            return index < bucket_count ? index : bucket_count - 1;
+        }
+
+        /**
+         * The counts of all threads, added up. Snapshots of histograms with the same layout can be merged.
+         */
+        struct snapshot
+        {
+            std::array<std::uint64_t, bucket_count> counts{};
+            std::uint64_t sum = 0;
+
+            std::uint64_t count() const noexcept
+            {
+                std::uint64_t total = 0;
+                for (std::uint64_t c : counts)
+                    total += c;
+                return total;
+            }
+
+            /**
+             * Method used to estimate a quantile.
+             *
+             * @param q                 The quantile, in [0, 1].
+             * @return                  The upper bound of the bucket holding the quantile, or 0 if there are no samples.
+             */
+            std::uint64_t quantile(double q) const noexcept
+            {
+                std::uint64_t total = count();
+                if (!total)
+                    return 0;
+                auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total - 1));
+                std::uint64_t seen = 0;
+                std::size_t b = 0;
+                for (; b + 1 < bucket_count; ++b)
+                    if ((seen += counts[b]) > rank)
+                        break;
+                return bounds[b + 1];
+            }
+
+            snapshot &operator+=(const snapshot &other) noexcept
+            {
+                for (std::size_t b = 0; b < bucket_count; ++b)
+                    counts[b] += other.counts[b];
+                sum += other.sum;
+                return *this;
+            }
+        }; // struct snapshot
+
+        histogram() = default;
+
+        /**
+         * Method used to count a value, in the storage of the calling thread.
+         *
+         * @param value             The value.
+         */
+        void record(std::uint64_t value) noexcept
+        {
+            storage &s = threads.local();
+            owner_add(s.counts[bucket_of(value)], std::uint64_t{1});
+            owner_add(s.sum, value);
+        }
+
+        /**
+         * Method used to add up the counts of all threads.
+         *
+         * @return                  The merged counts.
+         */
+        snapshot collect() const
+        {
+            snapshot result;
+            threads.for_each([&result](const storage &s)
+            {
+                for (std::size_t b = 0; b < bucket_count; ++b)
+                    result.counts[b] += s.counts[b].load(std::memory_order_relaxed);
+                result.sum += s.sum.load(std::memory_order_relaxed);
+            });
+            return result;
+        }
+
+        /**
+         * Method used to clear the counts of all threads. Must not run concurrently with record.
+         */
+        void reset()
+        {
+            threads.for_each([](storage &s)
+            {
+                for (auto &c : s.counts)
+                    c.store(0, std::memory_order_relaxed);
+                s.sum.store(0, std::memory_order_relaxed);
+            });
+        }
+
+    private:
+        static constexpr std::size_t log2(std::uint64_t value) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return 63 - static_cast<std::size_t>(__builtin_clzll(value));
+#else
+            std::size_t result = 0;
+            while (value >>= 1)
+                ++result;
+            return result;
+#endif
+        }
+
+        static constexpr std::size_t min_bits = log2(Min);
+        static constexpr std::size_t sub_bits = log2(SubBuckets);
+
+        struct storage
+        {
+            std::array<std::atomic<std::uint64_t>, bucket_count> counts{};
+            std::atomic<std::uint64_t> sum{0};
+        };
+
+        per_thread_registry<storage> threads;
+    }; // struct histogram
+} // namespace ctl
+#endif //CTL_HISTOGRAM_H
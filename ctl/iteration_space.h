@@ -0,0 +1,195 @@
+#ifndef CTL_ITERATION_SPACE_H
+#define CTL_ITERATION_SPACE_H
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#if __cplusplus >= 202002L && __has_include(<ranges>)
+#include <ranges>
+#endif
+/**
+ * iteration_space - The sequence of iterator values visited by a ctl::for_loop, computed at compile-time.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct that describes the values taken by the iterator of a for loop.
+     * The values are computed without instantiating any action functor.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam I                    The starting value of the iterator.
+     * @tparam N                    The value at which the iterator stops.
+     * @tparam update_functor       A functor used to update the iterator on each iteration.
+     * @tparam conditional_functor  A functor used to verify if the loop is still running.
+     */
+    template<typename T,
+            T I,
+            T N,
+            template<T> typename update_functor,
+            template<T, T> typename conditional_functor>
+    struct iteration_space
+    {
+        iteration_space() = delete;
+
+        using value_type = T;
+
+    private:
+        template<std::size_t A, std::size_t B>
+        static constexpr std::array<T, A + B> concat(const std::array<T, A> &a, const std::array<T, B> &b) noexcept
+        {
+            std::array<T, A + B> result{};
+            for (std::size_t i = 0; i < A; ++i)
+                result[i] = a[i];
+            for (std::size_t i = 0; i < B; ++i)
+                result[A + i] = b[i];
+            return result;
+        }
+
+        /**
+         * Helper struct used to collect up to K iterator values, starting from J.
+         * The walk is split in two halves, the second one starting where the first one stops, so the values
+         * are still visited in order but the instantiations only nest log2(K) deep.
+         *
+         * @tparam J                The current value of the iterator.
+         * @tparam K                The maximum number of values, a power of two.
+         * @tparam running          The value of the condition for J.
+         */
+        template<T J, std::size_t K, bool running = conditional_functor<J, N>{}()>
+        struct walk
+        {
+            static constexpr T next = J;
+            static constexpr bool done = true;
+            static constexpr std::array<T, 0> values{};
+        };
+
+        template<T J>
+        struct walk<J, 1, true>
+        {
+            static constexpr T next = update_functor<J>{}();
+            static constexpr bool done = !conditional_functor<next, N>{}();
+            static constexpr std::array<T, 1> values{J};
+        };
+
+        template<T J, std::size_t K>
+        struct walk<J, K, true>
+        {
+            using first = walk<J, K / 2>;
+            // If the first half is done, the condition fails at its next value and the second half is empty.
+            using second = walk<first::next, K - K / 2>;
+
+            static constexpr T next = second::next;
+            static constexpr bool done = second::done;
+            static constexpr auto values = concat(first::values, second::values);
+        };
+
+        /**
+         * Helper struct used to collect all the iterator values from J, in walks of doubling length,
+         * so that neither the number of walks nor their depth grows linearly with the number of iterations.
+         *
+         * @tparam J                The current value of the iterator.
+         * @tparam K                The length of the next walk.
+         */
+        template<T J, std::size_t K>
+        struct collector
+        {
+            using step = walk<J, K>;
+            using rest = std::conditional_t<step::done, walk<step::next, 1>, collector<step::next, 2 * K>>;
+
+            static constexpr auto values = concat(step::values, rest::values);
+        };
+
+    public:
+        /**
+         * The values of the iterator, in the order in which the loop visits them.
+         */
+        static constexpr auto values = collector<I, 1>::values;
+
+        /**
+         * The number of iterations of the loop.
+         */
+        static constexpr std::size_t size = values.size();
+
+        /**
+         * Static method used to find the position of a value in the loop.
+         *
+         * @param value             The value of the iterator.
+         * @return                  The index of the first iteration with that value, or size if the loop never reaches it.
+         */
+        static constexpr std::size_t index_of(T value) noexcept
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                if (values[i] == value)
+                    return i;
+            return size;
+        }
+    }; // struct iteration_space
+
+    /**
+     * Range over the values of an iteration_space, for use with the standard algorithms.
+     * The values live in a static constexpr array, so the iterators are plain pointers
+     * and the range works with the parallel algorithms and, in C++20, as a std::ranges view.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam I                    The starting value of the iterator.
+     * @tparam N                    The value at which the iterator stops.
+     * @tparam update_functor       A functor used to update the iterator on each iteration.
+     * @tparam conditional_functor  A functor used to verify if the loop is still running.
+     */
+    template<typename T,
+            T I,
+            T N,
+            template<T> typename update_functor,
+            template<T, T> typename conditional_functor>
+    struct iteration_range
+#if __cplusplus >= 202002L && __has_include(<ranges>)
+            : std::ranges::view_base
+#endif
+    {
+        using space = iteration_space<T, I, N, update_functor, conditional_functor>;
+
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using const_iterator = const T *;
+        using iterator = const_iterator;
+
+        constexpr const_iterator begin() const noexcept
+        {
+            return space::values.data();
+        }
+
+        constexpr const_iterator end() const noexcept
+        {
+            return space::values.data() + space::size;
+        }
+
+        constexpr const T *data() const noexcept
+        {
+            return space::values.data();
+        }
+
+        constexpr std::size_t size() const noexcept
+        {
+            return space::size;
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return space::size == 0;
+        }
+
+        constexpr T operator[](std::size_t i) const noexcept
+        {
+            return space::values[i];
+        }
+    }; // struct iteration_range
+} // namespace ctl
+
+#if __cplusplus >= 202002L && __has_include(<ranges>) && !defined(CTL_MODULE_INTERFACE)
+// The range does not own its values, so its iterators never dangle.
+// ctl.cppm declares this specialization itself, outside of its export block.
+template<typename T, T I, T N, template<T> typename update_functor, template<T, T> typename conditional_functor>
+inline constexpr bool std::ranges::enable_borrowed_range<ctl::iteration_range<T, I, N, update_functor, conditional_functor>> = true;
+#endif
+#endif //CTL_ITERATION_SPACE_H
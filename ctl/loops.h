@@ -0,0 +1,353 @@
+#ifndef CTL_LOOPS_H
+#define CTL_LOOPS_H
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "config.h"
+#include "iteration_space.h"
+/**
+ * loops - The compile-time loops of ctl. Does not depend on <iostream>.
+ */
+
+namespace ctl
+{
+    /**
+     * Controls how ctl::for_loop expands its iterations.
+     * inlined  - every action is called directly from the recursive expansion (the default, usable in constant expressions).
+     *            The recursion nests one instantiation per iteration, so the loop length is bounded by -ftemplate-depth.
+     * outlined - every action is compiled into its own non-inlined function, driven from a table of function pointers.
+     *            The table is built without linear recursion, so the loop length is not bounded by -ftemplate-depth.
+     * automatic - outlined if the loop has more than CTL_OUTLINE_THRESHOLD iterations, otherwise inlined.
+     */
+    enum class expansion_mode
+    {
+        automatic,
+        inlined,
+        outlined
+    };
+
+    /**
+     * Struct used to expand a for loop at compile-time.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam I                    The starting value of the iterator.
+     * @tparam N                    The value at which the iterator stops.
+     * @tparam update_functor       A functor used to update the iterator on each iteration.
+     * @tparam conditional_functor  A functor used to verify if the loop is still running.
+     * @tparam action_functor       A functor that performs the action on each iteration.
+     * @tparam mode                 How the iterations are expanded. Only inlined loops can run in constant expressions.
+     */
+    template<typename T,
+            T I,
+            T N,
+            template<T> typename update_functor,
+            template<T, T> typename conditional_functor,
+            template<T> typename action_functor,
+            expansion_mode mode = expansion_mode::inlined>
+    struct for_loop
+    {
+        for_loop() = delete;
+
+        using space = iteration_space<T, I, N, update_functor, conditional_functor>;
+        using range = iteration_range<T, I, N, update_functor, conditional_functor>;
+
+        /**
+         * Static method used to start the loop.
+         * Any arguments are passed (as lvalues) to the action functor on each iteration.
+         *
+         * @param params            Arguments forwarded to every call of the action functor.
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<typename ... Params>
+        static constexpr bool begin(Params && ... params) noexcept
+        {
+            if constexpr (mode == expansion_mode::automatic)
+            {
+                if constexpr (space::size > CTL_OUTLINE_THRESHOLD)
+                    return for_loop<T, I, N, update_functor, conditional_functor, action_functor, expansion_mode::outlined>::begin(params ...);
+                else
+                    return for_loop<T, I, N, update_functor, conditional_functor, action_functor, expansion_mode::inlined>::begin(params ...);
+            }
+            else if constexpr (mode == expansion_mode::outlined)
+            {
+                using table = outlined<std::make_index_sequence<space::size>, std::remove_reference_t<Params> ...>;
+                for (auto action : table::actions)
+                    action(params ...);
+                return space::size != 0;
+            }
+            else if constexpr (conditional_functor<I, N>{}())
+            {
+                action_functor<I>{}(params ...);
+                for_loop<T, update_functor<I>{}(), N, update_functor, conditional_functor, action_functor, mode>::begin(params ...);
+                return true;
+            }
+            return false;
+        }
+
+    private:
+        /**
+         * Helper static method that holds the action for one iteration in its own non-inlined function.
+         *
+         * @tparam J                The value of the iterator.
+         */
+        template<T J, typename ... Params>
+        CTL_NOINLINE static void outlined_action(Params & ... params) noexcept
+        {
+            action_functor<J>{}(params ...);
+        }
+
+        /**
+         * Helper struct holding the table of outlined actions, in iteration order.
+         */
+        template<typename Indices, typename ... Params>
+        struct outlined;
+
+        template<std::size_t ... Is, typename ... Params>
+        struct outlined<std::index_sequence<Is ...>, Params ...>
+        {
+            static constexpr std::array<void (*)(Params & ...) noexcept, sizeof...(Is)> actions{
+                    &outlined_action<space::values[Is], Params ...> ...};
+        };
+    }; // struct for_loop
+
+    /**
+     * Struct used to expand several for loops over the same iterator in a single pass.
+     * On each iteration, the actions are performed in the order in which they are listed.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam I                    The starting value of the iterator.
+     * @tparam N                    The value at which the iterator stops.
+     * @tparam update_functor       A functor used to update the iterator on each iteration.
+     * @tparam conditional_functor  A functor used to verify if the loop is still running.
+     * @tparam action_functors      A pack of functors that perform the actions on each iteration.
+     */
+    template<typename T,
+            T I,
+            T N,
+            template<T> typename update_functor,
+            template<T, T> typename conditional_functor,
+            template<T> typename ... action_functors>
+    struct fused_for_loop
+    {
+        fused_for_loop() = delete;
+
+        /**
+         * Static method used to start the loop.
+         * Any arguments are passed (as lvalues) to every action functor on each iteration.
+         *
+         * @param params            Arguments forwarded to every call of the action functors.
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<typename ... Params>
+        static constexpr bool begin(Params && ... params) noexcept
+        {
+            if constexpr (conditional_functor<I, N>{}())
+            {
+                (action_functors<I>{}(params ...), ...);
+                fused_for_loop<T, update_functor<I>{}(), N, update_functor, conditional_functor, action_functors ...>::begin(params ...);
+                return true;
+            }
+            return false;
+        }
+    }; // struct fused_for_loop
+
+    /**
+     * Struct used to perform an action for each value of an explicit list of constants, in the order in which they are listed.
+     * The expansion is flat (a fold over the list), so long lists do not recurse.
+     *
+     * @tparam T                    The type of the values.
+     * @tparam Values               The values visited by the loop.
+     */
+    template<typename T, T ... Values>
+    struct for_each_value
+    {
+        for_each_value() = delete;
+
+        /**
+         * Static method used to start the loop.
+         * Any arguments are passed (as lvalues) to the action functor on each iteration.
+         *
+         * @tparam action_functor   A functor that performs the action on each iteration.
+         * @param params            Arguments forwarded to every call of the action functor.
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<template<T> typename action_functor, typename ... Params>
+        static constexpr bool begin([[maybe_unused]] Params && ... params) noexcept
+        {
+            (action_functor<Values>{}(params ...), ...);
+            return sizeof...(Values) != 0;
+        }
+    }; // struct for_each_value
+
+    /**
+     * Struct used to perform an action for each value of a std::integer_sequence.
+     *
+     * @tparam Sequence             A std::integer_sequence with the values visited by the loop.
+     */
+    template<typename Sequence>
+    struct for_each_in;
+
+    template<typename T, T ... Values>
+    struct for_each_in<std::integer_sequence<T, Values ...>> : for_each_value<T, Values ...>
+    {
+    };
+
+    /**
+     * Struct that describes one of the iterators advanced by ctl::zip_for.
+     *
+     * @tparam T                    The type of the iterator.
+     * @tparam I                    The starting value of the iterator.
+     * @tparam N                    The value at which the iterator stops.
+     * @tparam update_functor       A functor used to update the iterator on each iteration.
+     * @tparam conditional_functor  A functor used to verify if the iterator is still running.
+     */
+    template<typename T,
+            T I,
+            T N,
+            template<T> typename update_functor,
+            template<T, T> typename conditional_functor>
+    struct zip_iterator
+    {
+        zip_iterator() = delete;
+
+        using space = iteration_space<T, I, N, update_functor, conditional_functor>;
+
+        static constexpr std::size_t size = space::size;
+
+        /**
+         * The value of the iterator on iteration K.
+         */
+        template<std::size_t K>
+        static constexpr T at = space::values[K];
+    }; // struct zip_iterator
+
+    /**
+     * Struct that describes an unbounded iterator counting up from I, used to number the iterations of ctl::zip_for.
+     *
+     * @tparam T                    The type of the iterator.
+     * @tparam I                    The starting value of the iterator.
+     */
+    template<typename T, T I = 0>
+    struct counting_iterator
+    {
+        counting_iterator() = delete;
+
+        static constexpr std::size_t size = static_cast<std::size_t>(-1);
+
+        template<std::size_t K>
+        static constexpr T at = static_cast<T>(I + K);
+    }; // struct counting_iterator
+
+    /**
+     * Struct used to expand a for loop that advances several iterators in lockstep.
+     * The loop stops as soon as one of the iterators stops, so at least one of them must be bounded.
+     * The iterations are expanded from the iteration spaces of the iterators, without a recursion level per step.
+     *
+     * @tparam action_functor       A functor that performs the action on each iteration, given the value of every iterator.
+     * @tparam Iterators            The iterators, ctl::zip_iterator or ctl::counting_iterator.
+     */
+    template<template<auto ...> typename action_functor, typename ... Iterators>
+    struct zip_for
+    {
+        static_assert(sizeof...(Iterators) > 0, "[ctl::zip_for]: at least one iterator is required");
+
+        zip_for() = delete;
+
+        /**
+         * The number of iterations of the loop.
+         */
+        static constexpr std::size_t size = []
+        {
+            std::size_t result = static_cast<std::size_t>(-1);
+            ((result = Iterators::size < result ? Iterators::size : result), ...);
+            return result;
+        }();
+
+        static_assert(size != static_cast<std::size_t>(-1), "[ctl::zip_for]: at least one iterator must be bounded");
+
+        /**
+         * Static method used to start the loop.
+         * Any arguments are passed (as lvalues) to the action functor on each iteration.
+         *
+         * @param params            Arguments forwarded to every call of the action functor.
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<typename ... Params>
+        static constexpr bool begin(Params && ... params) noexcept
+        {
+            expand(std::make_index_sequence<size>{}, params ...);
+            return size != 0;
+        }
+
+    private:
+        template<std::size_t K, typename ... Params>
+        static constexpr void step(Params & ... params) noexcept
+        {
+            action_functor<Iterators::template at<K> ...>{}(params ...);
+        }
+
+        template<std::size_t ... Ks, typename ... Params>
+        static constexpr void expand(std::index_sequence<Ks ...>, [[maybe_unused]] Params & ... params) noexcept
+        {
+            (step<Ks>(params ...), ...);
+        }
+    }; // struct zip_for
+
+    /**
+     * Struct used to expand a while loop at compile-time.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam conditional_functor  A functor used to verify if the loop is still running.
+     * @tparam action_functor       A functor that performs the action on each iteration.
+     * @tparam Args                 A pack of template arguments that represents the initial values of all loop parameters.
+     */
+    template<typename T,
+            template<T ...> typename conditional_functor,
+            template<T ...> typename action_functor,
+            T ... Args>
+    struct while_loop
+    {
+        while_loop() = delete;
+
+        /**
+         * Static method used to start the loop.
+         *
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        static constexpr bool begin() noexcept
+        {
+            if constexpr (conditional_functor<Args ...>{}())
+            {
+                next_iter(action_functor<Args ...>{}());
+                return true;
+            }
+            return false;
+        }
+
+        /**
+        * Static method used to start a do-while type loop.
+        *
+        * @return                  always true.
+        */
+        static constexpr bool do_while_begin() noexcept
+        {
+            next_iter(action_functor<Args ...>{}());
+            return true;
+        }
+
+        /**
+         * Helper static method used to unpack the std::integer_sequence template arguments and pass them to the next iteration
+         *
+         * @tparam Ints             A pack of template arguments representing the current values of all loop parameters.
+         */
+        template<T ... Ints>
+        static constexpr void next_iter(std::integer_sequence<T, Ints ...> &&) noexcept
+        {
+            if constexpr (conditional_functor<Ints ...>{}())
+                next_iter(action_functor<Ints ...>{}());
+        };
+    };// struct while_loop
+} // namespace ctl
+#endif //CTL_LOOPS_H
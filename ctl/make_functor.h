@@ -1,5 +1,9 @@
 #ifndef CTL_MAKE_FUNCTOR_H
 #define CTL_MAKE_FUNCTOR_H
+
+#include <array>
+#include <cstddef>
+#include <utility>
 /**
  * make_functor - API to convert functions into functors used by ctl.
  * Only creates functors for ctl::for_loop.
@@ -48,5 +52,48 @@ namespace ctl
             }
         };
     };
+
+    /**
+     * Precomputes a function over [Lo, Hi) into a constexpr table.
+     * Arguments inside the range are served from the table, any other argument falls back to calling the function.
+     *
+     * @tparam T                    The argument and result type of the function.
+     * @tparam func                 A constexpr function pointer.
+     * @tparam Lo                   The first tabulated argument.
+     * @tparam Hi                   The first argument past the table.
+     */
+    template<typename T, T (*func)(T), T Lo, T Hi>
+    struct memoize
+    {
+        static_assert(Lo <= Hi, "[ctl::memoize]: the table range must not be reversed");
+
+        static constexpr std::size_t size = static_cast<std::size_t>(Hi - Lo);
+
+    private:
+        template<std::size_t ... Is>
+        static constexpr std::array<T, size> make_table(std::index_sequence<Is ...>) noexcept
+        {
+            return {func(static_cast<T>(Lo + static_cast<T>(Is))) ...};
+        }
+
+    public:
+        static constexpr std::array<T, size> table = make_table(std::make_index_sequence<size>{});
+
+        constexpr T operator()(T x) const noexcept
+        {
+            if (x >= Lo && x < Hi)
+                return table[static_cast<std::size_t>(x - Lo)];
+            return func(x);
+        }
+
+        template<T I>
+        struct instance
+        {
+            constexpr T operator()() const noexcept
+            {
+                return memoize{}(I);
+            }
+        };
+    };
 } // namespace ctl
 #endif //CTL_MAKE_FUNCTOR_H
@@ -0,0 +1,216 @@
+#ifndef CTL_MATH_TABLE_H
+#define CTL_MATH_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <ratio>
+#include <utility>
+/**
+ * math_table - Lookup tables of mathematical functions sampled at compile-time, with interpolated runtime lookups.
+ */
+
+namespace ctl
+{
+    /**
+     * Function objects evaluated with power series, usable in constant expressions.
+     */
+    namespace math
+    {
+        inline constexpr double pi = 3.14159265358979323846;
+        inline constexpr double ln2 = 0.69314718055994530942;
+
+        struct sin
+        {
+            constexpr double operator()(double x) const noexcept
+            {
+                if (!(x - x == 0))
+                    return std::numeric_limits<double>::quiet_NaN();
+                // Reduce to [-pi, pi], then sum the Taylor series until the terms vanish.
+                // From 2^52 turns on, a double has no fraction of a turn left to reduce to.
+                double turns = x / (2 * pi);
+                if (!(turns < 0x1p52 && turns > -0x1p52))
+                    return 0;
+                auto k = static_cast<long long>(turns < 0 ? turns - 0.5 : turns + 0.5);
+                x -= static_cast<double>(k) * 2 * pi;
+                double term = x, sum = x;
+                for (int n = 1; n < 30 && term != 0; ++n)
+                {
+                    term *= -x * x / ((2 * n) * (2 * n + 1));
+                    sum += term;
+                }
+                return sum;
+            }
+        };
+
+        struct cos
+        {
+            constexpr double operator()(double x) const noexcept
+            {
+                return sin{}(x + pi / 2);
+            }
+        };
+
+        struct exp
+        {
+            constexpr double operator()(double x) const noexcept
+            {
+                if (x != x)
+                    return x;
+                // Beyond these bounds the result overflows to infinity or underflows to zero.
+                if (x > 710)
+                    return std::numeric_limits<double>::infinity();
+                if (x < -746)
+                    return 0;
+                // exp(x) = 2^k * exp(r), with |r| <= ln2 / 2.
+                double halves = x / ln2;
+                auto k = static_cast<long long>(halves < 0 ? halves - 0.5 : halves + 0.5);
+                double r = x - static_cast<double>(k) * ln2;
+                double term = 1, sum = 1;
+                for (int n = 1; n < 30 && term != 0; ++n)
+                {
+                    term *= r / n;
+                    sum += term;
+                }
+                for (; k > 0; --k)
+                    sum *= 2;
+                for (; k < 0; ++k)
+                    sum /= 2;
+                return sum;
+            }
+        };
+
+        struct log
+        {
+            constexpr double operator()(double x) const noexcept
+            {
+                if (x != x || x == std::numeric_limits<double>::infinity())
+                    return x;
+                if (x < 0)
+                    return std::numeric_limits<double>::quiet_NaN();
+                if (x == 0)
+                    return -std::numeric_limits<double>::infinity();
+                // log(x) = e * ln2 + log(m), with m in [1, 2), and log(m) = 2 * atanh((m - 1) / (m + 1)).
+                int e = 0;
+                for (; x >= 2; x /= 2)
+                    ++e;
+                for (; x < 1; x *= 2)
+                    --e;
+                double y = (x - 1) / (x + 1);
+                double power = y, sum = 0;
+                for (int n = 1; n < 80 && power != 0; n += 2)
+                {
+                    sum += power / n;
+                    power *= y * y;
+                }
+                return e * ln2 + 2 * sum;
+            }
+        };
+    } // namespace math
+
+    /**
+     * The ways of reconstructing a function between two samples.
+     */
+    enum class interpolation
+    {
+        nearest,
+        linear,
+        cubic
+    };
+
+    /**
+     * Struct holding N + 1 evenly spaced samples of a function over [Lo, Hi], computed at compile-time.
+     * Lookups clamp the argument to [Lo, Hi], and return NaN for NaN.
+     *
+     * @tparam Func                 A function object type with a constexpr call operator taking and returning double.
+     * @tparam Lo                   A std::ratio with the lower bound of the domain.
+     * @tparam Hi                   A std::ratio with the upper bound of the domain.
+     * @tparam N                    The number of intervals between samples.
+     */
+    template<typename Func, typename Lo, typename Hi, std::size_t N>
+    struct math_table
+    {
+        static_assert(N > 0, "[ctl::math_table]: at least one interval is required");
+        static_assert(std::ratio_less_v<Lo, Hi>, "[ctl::math_table]: the domain must not be empty");
+
+        math_table() = delete;
+
+        static constexpr double lo = static_cast<double>(Lo::num) / Lo::den;
+        static constexpr double hi = static_cast<double>(Hi::num) / Hi::den;
+        static constexpr double step = (hi - lo) / N;
+
+    private:
+        static constexpr double inverse_step = N / (hi - lo);
+
+        // The samples at Lo + i * step for i in [0, N], padded on both sides by linear extrapolation for cubic interpolation,
+        // so that the function is never evaluated outside of its domain.
+        template<std::size_t ... Is>
+        static constexpr std::array<double, N + 3> make_samples(std::index_sequence<Is ...>) noexcept
+        {
+            std::array<double, N + 3> result{0, Func{}(lo + static_cast<double>(Is) * step) ..., 0};
+            result[0] = 2 * result[1] - result[2];
+            result[N + 2] = 2 * result[N + 1] - result[N];
+            return result;
+        }
+
+    public:
+        static constexpr std::array<double, N + 3> samples = make_samples(std::make_index_sequence<N + 1>{});
+
+        /**
+         * Static method used to evaluate the function from the table.
+         *
+         * @tparam mode             How the function is reconstructed between samples.
+         * @param x                 The argument of the function.
+         * @return                  The approximated value of the function.
+         */
+        template<interpolation mode = interpolation::linear>
+        static constexpr double lookup(double x) noexcept
+        {
+            if (x != x)
+                return x;
+            double pos = (x - lo) * inverse_step;
+            pos = pos < 0 ? 0 : (pos > N ? N : pos);
+            if constexpr (mode == interpolation::nearest)
+                return samples[static_cast<std::size_t>(pos + 0.5) + 1];
+            else
+            {
+                std::size_t i = static_cast<std::size_t>(pos);
+                i = i < N ? i : N - 1;
+                double t = pos - static_cast<double>(i);
+                const double *s = samples.data() + i + 1;
+                if constexpr (mode == interpolation::linear)
+                    return s[0] + t * (s[1] - s[0]);
+                else
+                {
+                    // Catmull-Rom spline through s[-1], s[0], s[1], s[2].
+                    double a = -0.5 * s[-1] + 1.5 * s[0] - 1.5 * s[1] + 0.5 * s[2];
+                    double b = s[-1] - 2.5 * s[0] + 2 * s[1] - 0.5 * s[2];
+                    double c = -0.5 * s[-1] + 0.5 * s[1];
+                    return ((a * t + b) * t + c) * t + s[0];
+                }
+            }
+        }
+
+        /**
+         * Static method used to measure the error of the table, at the samples and at three points inside each interval.
+         * Meant to be evaluated at compile-time.
+         *
+         * @tparam mode             How the function is reconstructed between samples.
+         * @return                  The maximum absolute difference between the table and the function.
+         */
+        template<interpolation mode = interpolation::linear>
+        static constexpr double max_error() noexcept
+        {
+            double result = 0;
+            for (std::size_t i = 0; i <= 4 * N; ++i)
+            {
+                double x = lo + static_cast<double>(i) * step / 4;
+                double error = lookup<mode>(x) - Func{}(x);
+                error = error < 0 ? -error : error;
+                result = error > result ? error : result;
+            }
+            return result;
+        }
+    }; // struct math_table
+} // namespace ctl
+#endif //CTL_MATH_TABLE_H
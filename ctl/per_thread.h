@@ -0,0 +1,205 @@
+#ifndef CTL_PER_THREAD_H
+#define CTL_PER_THREAD_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+/**
+ * per_thread - Storage owned by a shared object but written by one thread each, without locks.
+ */
+
+namespace ctl
+{
+    /**
+     * A storage of a per_thread_registry, handed to one thread at a time.
+     */
+    template<typename Storage>
+    struct per_thread_slot
+    {
+        Storage storage{};
+        std::atomic<bool> in_use{true};
+    };
+
+    /**
+     * The claim of a thread on a slot, released when the thread exits or drops the slot.
+     * The slot is shared with the registry, so it stays valid whichever of the two goes first.
+     */
+    template<typename Storage>
+    struct per_thread_lease
+    {
+        std::shared_ptr<per_thread_slot<Storage>> slot;
+
+        explicit per_thread_lease(std::shared_ptr<per_thread_slot<Storage>> slot) noexcept : slot(std::move(slot))
+        {
+        }
+
+        per_thread_lease(const per_thread_lease &) = delete;
+        per_thread_lease &operator=(const per_thread_lease &) = delete;
+
+        ~per_thread_lease()
+        {
+            slot->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    /**
+     * An entry of the table of a thread, valid while its generation matches the registry that owns the id.
+     */
+    template<typename Storage>
+    struct per_thread_entry
+    {
+        std::uint64_t generation = 0;
+        Storage *storage = nullptr;
+        std::unique_ptr<per_thread_lease<Storage>> lease;
+    };
+
+    /**
+     * The table of each thread mapping registry ids to storage, for the registries of Storage.
+     * Its destructor releases the slots of the thread when it exits. It is a static data member because GCC 12
+     * cannot export the ctl module with a function-local thread_local object that has a destructor,
+     * and does not run the destructor of a thread_local variable template.
+     */
+    template<typename Storage>
+    struct per_thread_table
+    {
+        per_thread_table() = delete;
+
+        static inline thread_local std::vector<per_thread_entry<Storage>> entries;
+    };
+
+    /**
+     * Struct that gives every thread its own Storage for each registry object.
+     * A thread finds its storage in a thread-local table indexed by the id of the registry, so after the first
+     * access from a thread there is no lock and no search. The storage belongs to the registry and outlives
+     * its thread, so the results of finished threads can still be read; once a thread has exited, its storage
+     * is handed, with its contents, to the next thread that needs one.
+     * Ids are recycled when a registry is destroyed, so the tables only grow with the number of live registries.
+     *
+     * @tparam Storage              The per-thread data, default constructible.
+     */
+    template<typename Storage>
+    struct per_thread_registry
+    {
+        per_thread_registry()
+        {
+            ids &pool = id_pool();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            // The generation is never reused, so the entries left by a destroyed registry with the same id are stale.
+            generation = ++pool.generation;
+            if (pool.free.empty())
+                id = pool.next++;
+            else
+            {
+                id = pool.free.back();
+                pool.free.pop_back();
+            }
+        }
+
+        per_thread_registry(const per_thread_registry &) = delete;
+        per_thread_registry &operator=(const per_thread_registry &) = delete;
+
+        ~per_thread_registry()
+        {
+            ids &pool = id_pool();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            pool.free.push_back(id);
+        }
+
+        /**
+         * Method used to get the storage of the calling thread, created or taken over on its first access.
+         */
+        Storage &local()
+        {
+            std::vector<per_thread_entry<Storage>> &table = per_thread_table<Storage>::entries;
+            if (id < table.size() && table[id].generation == generation)
+                return *table[id].storage;
+            return attach(table);
+        }
+
+        /**
+         * Method used to visit the storage of every thread, under the lock of the registry.
+         * The owning threads may still be writing, so Storage should hold atomics written with owner_add.
+         *
+         * @param f                 A callable invoked with a reference to each storage.
+         */
+        template<typename F>
+        void for_each(F &&f)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto &s : slots)
+                f(s->storage);
+        }
+
+        template<typename F>
+        void for_each(F &&f) const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto &s : slots)
+                f(static_cast<const Storage &>(s->storage));
+        }
+
+    private:
+        struct ids
+        {
+            std::mutex mutex;
+            std::vector<std::size_t> free;
+            std::size_t next = 0;
+            std::uint64_t generation = 0;
+        };
+
+        std::size_t id;
+        std::uint64_t generation;
+        mutable std::mutex mutex;
+        std::vector<std::shared_ptr<per_thread_slot<Storage>>> slots;
+
+        static ids &id_pool() noexcept
+        {
+            static ids instance;
+            return instance;
+        }
+
+        Storage &attach(std::vector<per_thread_entry<Storage>> &table)
+        {
+            std::shared_ptr<per_thread_slot<Storage>> slot;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (const auto &s : slots)
+                {
+                    bool released = false;
+                    if (s->in_use.compare_exchange_strong(released, true, std::memory_order_acquire))
+                    {
+                        slot = s;
+                        break;
+                    }
+                }
+                if (!slot)
+                    slot = slots.emplace_back(std::make_shared<per_thread_slot<Storage>>());
+            }
+            if (table.size() <= id)
+                table.resize(id + 1);
+            // Replacing a stale entry releases the slot of the destroyed registry, freeing it if nothing else holds it.
+            per_thread_entry<Storage> &entry = table[id];
+            entry.storage = &slot->storage;
+            entry.lease = std::make_unique<per_thread_lease<Storage>>(std::move(slot));
+            entry.generation = generation;
+            return *entry.storage;
+        }
+    }; // struct per_thread_registry
+
+    /**
+     * Function used to add to a counter that only the calling thread writes, while other threads may read it.
+     * A relaxed load and store is enough, and cheaper than a read-modify-write.
+     *
+     * @param counter               The counter.
+     * @param delta                 The amount added.
+     */
+    template<typename T>
+    inline void owner_add(std::atomic<T> &counter, T delta) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+} // namespace ctl
+#endif //CTL_PER_THREAD_H
@@ -0,0 +1,175 @@
+#ifndef CTL_PERFECT_HASH_MAP_H
+#define CTL_PERFECT_HASH_MAP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+/**
+ * perfect_hash_map - Collision-free lookup tables for a fixed set of keys, built at compile-time.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct that maps each key of a fixed set to its position in the set.
+     * A hash seed for which no two keys share a slot is searched for at compile-time,
+     * so a lookup is one hash, one table load and one comparison.
+     *
+     * @tparam Keys                 The keys, either integers/enums or pointers to null-terminated strings with static storage.
+     */
+    template<auto ... Keys>
+    struct perfect_hash_map
+    {
+        static_assert(sizeof...(Keys) > 0, "[ctl::perfect_hash_map]: the key set must not be empty");
+
+        perfect_hash_map() = delete;
+
+        static constexpr bool is_string = (std::is_same_v<std::decay_t<decltype(Keys)>, const char *> && ...);
+
+        using key_type = std::conditional_t<is_string, std::string_view, std::common_type_t<decltype(Keys) ...>>;
+
+        /**
+         * The number of keys, also returned by index_of for keys that are not in the set.
+         */
+        static constexpr std::size_t size = sizeof...(Keys);
+        static constexpr std::size_t npos = size;
+
+        /**
+         * The keys, in the order in which they were given.
+         */
+        static constexpr std::array<key_type, size> keys{key_type(Keys) ...};
+
+        /**
+         * Static method used to hash a key.
+         *
+         * @param key               The key to be hashed.
+         * @param seed              The seed of the hash function.
+         * @return                  The 64-bit hash of the key.
+         */
+        static constexpr std::uint64_t hash(key_type key, std::uint64_t seed) noexcept
+        {
+            std::uint64_t h = 0;
+            if constexpr (is_string)
+            {
+                h = 0xcbf29ce484222325ULL ^ seed;
+                for (char c : key)
+                {
+                    h ^= static_cast<unsigned char>(c);
+                    h *= 0x100000001b3ULL;
+                }
+            }
+            else
+                h = static_cast<std::uint64_t>(key) ^ seed;
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+    private:
+        static constexpr std::size_t min_table_size = []
+        {
+            std::size_t result = 1;
+            while (result < size)
+                result <<= 1;
+            return result;
+        }();
+
+        // The table grows up to max_table_size slots, trying max_attempts seeds for each size.
+        static constexpr std::size_t max_table_size = min_table_size << 4;
+        static constexpr std::uint64_t max_attempts = 1024;
+
+        struct layout
+        {
+            std::size_t table_size;
+            std::uint64_t seed;
+        };
+
+        static constexpr bool unique_keys() noexcept
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                for (std::size_t j = i + 1; j < size; ++j)
+                    if (keys[i] == keys[j])
+                        return false;
+            return true;
+        }
+
+        static constexpr bool collision_free(std::size_t table_size, std::uint64_t seed) noexcept
+        {
+            std::array<bool, max_table_size> used{};
+            for (key_type key : keys)
+            {
+                std::size_t slot = hash(key, seed) & (table_size - 1);
+                if (used[slot])
+                    return false;
+                used[slot] = true;
+            }
+            return true;
+        }
+
+        static constexpr layout search() noexcept
+        {
+            for (std::size_t table_size = min_table_size; table_size <= max_table_size; table_size <<= 1)
+                for (std::uint64_t attempt = 0; attempt < max_attempts; ++attempt)
+                {
+                    std::uint64_t seed = attempt * 0x9e3779b97f4a7c15ULL;
+                    if (collision_free(table_size, seed))
+                        return {table_size, seed};
+                }
+            return {0, 0};
+        }
+
+        static_assert(unique_keys(), "[ctl::perfect_hash_map]: the keys must be distinct");
+
+        static constexpr layout found = search();
+
+        static_assert(found.table_size != 0, "[ctl::perfect_hash_map]: no collision-free seed was found");
+
+    public:
+        static constexpr std::size_t table_size = found.table_size;
+        static constexpr std::uint64_t seed = found.seed;
+
+    private:
+        static constexpr std::array<std::size_t, table_size> make_slots() noexcept
+        {
+            std::array<std::size_t, table_size> result{};
+            for (std::size_t &slot : result)
+                slot = npos;
+            for (std::size_t i = 0; i < size; ++i)
+                result[hash(keys[i], seed) & (table_size - 1)] = i;
+            return result;
+        }
+
+        // Keys followed by a sentinel, so that empty slots can be compared without a branch.
+        static constexpr std::array<key_type, size + 1> padded_keys{key_type(Keys) ..., key_type{}};
+
+    public:
+        /**
+         * The position in Keys of the key stored in each slot, or npos for empty slots.
+         */
+        static constexpr std::array<std::size_t, table_size> slots = make_slots();
+
+        /**
+         * Static method used to look up a key.
+         * The result can index a dispatch table of size + 1 entries, the last one handling unknown keys.
+         *
+         * @param key               The key to be looked up.
+         * @return                  The position of the key in Keys, or npos if it is not in the set.
+         */
+        static constexpr std::size_t index_of(key_type key) noexcept
+        {
+            std::size_t i = slots[hash(key, seed) & (table_size - 1)];
+            return padded_keys[i] == key ? i : npos;
+        }
+
+        static constexpr bool contains(key_type key) noexcept
+        {
+            return index_of(key) != npos;
+        }
+    }; // struct perfect_hash_map
+} // namespace ctl
+#endif //CTL_PERFECT_HASH_MAP_H
@@ -0,0 +1,343 @@
+#ifndef CTL_PIPELINE_H
+#define CTL_PIPELINE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+/**
+ * pipeline - Multi-threaded stage pipelines wired at compile-time, connected by lock-free single-producer/single-consumer queues.
+ */
+
+namespace ctl
+{
+    /**
+     * Bounded lock-free queue with exactly one producer thread and one consumer thread.
+     * Items are moved in and out in batches, publishing each batch with a single atomic store.
+     *
+     * @tparam T                    The type of the items, which must be default constructible and movable.
+     * @tparam Capacity             The maximum number of queued items, a power of two.
+     */
+    template<typename T, std::size_t Capacity>
+    struct spsc_queue
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "[ctl::spsc_queue]: the capacity must be a power of two");
+
+        /**
+         * Method used by the producer to enqueue as many of the given items as there is room for.
+         *
+         * @param items             Pointer to the first item, the enqueued items are moved from.
+         * @param n                 The number of items.
+         * @return                  The number of items that were enqueued.
+         */
+        std::size_t try_push(T *items, std::size_t n)
+        {
+            std::size_t tail = tail_index.load(std::memory_order_relaxed);
+            if (Capacity - (tail - cached_head) < n)
+                cached_head = head_index.load(std::memory_order_acquire);
+            std::size_t free = Capacity - (tail - cached_head);
+            std::size_t count = n < free ? n : free;
+            for (std::size_t i = 0; i < count; ++i)
+                buffer[(tail + i) & (Capacity - 1)] = std::move(items[i]);
+            tail_index.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * Method used by the consumer to dequeue up to n items.
+         *
+         * @param out               Pointer to where the dequeued items are moved.
+         * @param n                 The maximum number of items.
+         * @return                  The number of items that were dequeued.
+         */
+        std::size_t try_pop(T *out, std::size_t n)
+        {
+            std::size_t head = head_index.load(std::memory_order_relaxed);
+            if (cached_tail - head < n)
+                cached_tail = tail_index.load(std::memory_order_acquire);
+            std::size_t available = cached_tail - head;
+            std::size_t count = n < available ? n : available;
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = std::move(buffer[(head + i) & (Capacity - 1)]);
+            head_index.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * Method used by the producer to signal that no more items will be enqueued.
+         */
+        void close() noexcept
+        {
+            closed_flag.store(true, std::memory_order_release);
+        }
+
+        bool closed() const noexcept
+        {
+            return closed_flag.load(std::memory_order_acquire);
+        }
+
+    private:
+        // The consumer side and the producer side live on separate cache lines.
+        alignas(64) std::atomic<std::size_t> head_index{0};
+        std::size_t cached_tail = 0;
+        alignas(64) std::atomic<std::size_t> tail_index{0};
+        std::size_t cached_head = 0;
+        std::atomic<bool> closed_flag{false};
+        alignas(64) std::array<T, Capacity> buffer{};
+    }; // struct spsc_queue
+
+    /**
+     * Functor that runs several stages one after the other, used to put a group of stages on a single thread.
+     *
+     * @tparam Stages               The stages, default constructible functors taking the output of the previous stage.
+     */
+    template<typename ... Stages>
+    struct stage_group
+    {
+        template<typename Input>
+        auto operator()(Input &&input)
+        {
+            return apply<0>(std::forward<Input>(input));
+        }
+
+    private:
+        std::tuple<Stages ...> stages;
+
+        template<std::size_t K, typename Input>
+        auto apply(Input &&input)
+        {
+            if constexpr (K == sizeof...(Stages))
+                return std::forward<Input>(input);
+            else
+                return apply<K + 1>(std::get<K>(stages)(std::forward<Input>(input)));
+        }
+    }; // struct stage_group
+
+    /**
+     * Struct used to run items through a fixed sequence of stages, each stage on its own thread.
+     * The stages are connected by spsc_queues and exchange items in batches; a stage that is about to wait
+     * for input first passes on the items it has, so a slow producer does not hold back the ones already done.
+     * If a stage throws, the pipeline stops and run rethrows the exception once all the threads have finished.
+     *
+     * @tparam Capacity             The capacity of each queue between two stages.
+     * @tparam Batch                The maximum number of items a stage moves through a queue at once.
+     * @tparam Stages               The stages, default constructible functors taking the output of the previous stage.
+     */
+    template<std::size_t Capacity, std::size_t Batch, typename ... Stages>
+    struct basic_pipeline
+    {
+        static_assert(sizeof...(Stages) > 0, "[ctl::pipeline]: at least one stage is required");
+        static_assert(Batch > 0 && Batch <= Capacity, "[ctl::pipeline]: the batch size must be between 1 and the queue capacity");
+
+        basic_pipeline() = delete;
+
+        static constexpr std::size_t stage_count = sizeof...(Stages);
+
+        template<std::size_t K>
+        using stage = std::tuple_element_t<K, std::tuple<Stages ...>>;
+
+        /**
+         * The type of the items produced by stage K, for a given input type.
+         */
+        template<typename Input, std::size_t K>
+        struct output_of
+        {
+            using type = std::decay_t<std::invoke_result_t<stage<K> &, typename output_of<Input, K - 1>::type>>;
+        };
+
+        template<typename Input>
+        struct output_of<Input, 0>
+        {
+            using type = std::decay_t<std::invoke_result_t<stage<0> &, Input>>;
+        };
+
+        /**
+         * Static method used to run the items of a range through the pipeline.
+         * The calling thread collects the results, in input order.
+         *
+         * @param first             The beginning of the input range.
+         * @param last              The end of the input range.
+         * @param out               The iterator where the results are written.
+         * @return                  The output iterator past the last result.
+         */
+        template<typename InputIt, typename OutputIt>
+        static OutputIt run(InputIt first, InputIt last, OutputIt out)
+        {
+            using input_type = typename std::iterator_traits<InputIt>::value_type;
+            return run_stages<input_type>(first, last, out, std::make_index_sequence<stage_count>{});
+        }
+
+        /**
+         * Static method used to run the items of a range through the stages on the calling thread only, for comparison.
+         *
+         * @param first             The beginning of the input range.
+         * @param last              The end of the input range.
+         * @param out               The iterator where the results are written.
+         * @return                  The output iterator past the last result.
+         */
+        template<typename InputIt, typename OutputIt>
+        static OutputIt run_serial(InputIt first, InputIt last, OutputIt out)
+        {
+            stage_group<Stages ...> stages;
+            for (; first != last; ++first)
+                *out++ = stages(*first);
+            return out;
+        }
+
+    private:
+        template<typename T>
+        using queue = spsc_queue<T, Capacity>;
+
+        // Shared by the threads of one run: the exceptions thrown by the stages, one slot per stage,
+        // and the flag that tells every thread to give up once one of them has failed.
+        struct control
+        {
+            std::atomic<bool> cancelled{false};
+            std::array<std::exception_ptr, stage_count> errors;
+
+            bool stopped() const noexcept
+            {
+                return cancelled.load(std::memory_order_relaxed);
+            }
+        };
+
+        // Blocks until all n items have been enqueued, or the pipeline is stopped.
+        template<typename T>
+        static void push_all(queue<T> &q, T *items, std::size_t n, const control &state)
+        {
+            for (std::size_t pushed = 0; pushed < n;)
+            {
+                std::size_t count = q.try_push(items + pushed, n - pushed);
+                if (!count)
+                {
+                    if (state.stopped())
+                        return;
+                    std::this_thread::yield();
+                }
+                pushed += count;
+            }
+        }
+
+        // Blocks until at least one item is dequeued, returns 0 once the queue is closed and empty, or the pipeline
+        // is stopped. before_wait is called whenever the queue is found empty, before waiting for it.
+        template<typename T, typename F>
+        static std::size_t pop_some(queue<T> &q, T *out, const control &state, F &&before_wait)
+        {
+            for (;;)
+            {
+                if (std::size_t count = q.try_pop(out, Batch))
+                    return count;
+                if (q.closed())
+                    return q.try_pop(out, Batch);
+                if (state.stopped())
+                    return 0;
+                before_wait();
+                std::this_thread::yield();
+            }
+        }
+
+        template<typename Input, std::size_t K, typename Queues, typename InputIt>
+        static void stage_thread(Queues &queues, control &state, InputIt first, InputIt last)
+        {
+            using output_type = typename output_of<Input, K>::type;
+            queue<output_type> &target = *std::get<K>(queues);
+            try
+            {
+                stage<K> current{};
+                std::vector<output_type> batch;
+                batch.reserve(Batch);
+                auto flush = [&]
+                {
+                    push_all(target, batch.data(), batch.size(), state);
+                    batch.clear();
+                };
+                auto emit = [&](auto &&item)
+                {
+                    batch.push_back(current(std::forward<decltype(item)>(item)));
+                    if (batch.size() == Batch)
+                        flush();
+                };
+                if constexpr (K == 0)
+                {
+                    for (; first != last && !state.stopped(); ++first)
+                        emit(*first);
+                }
+                else
+                {
+                    using input_type = typename output_of<Input, K - 1>::type;
+                    queue<input_type> &source = *std::get<K - 1>(queues);
+                    std::vector<input_type> items(Batch);
+                    auto flush_partial = [&]
+                    {
+                        if (!batch.empty())
+                            flush();
+                    };
+                    while (std::size_t count = pop_some(source, items.data(), state, flush_partial))
+                        for (std::size_t i = 0; i < count; ++i)
+                            emit(std::move(items[i]));
+                }
+                flush();
+            }
+            catch (...)
+            {
+                state.errors[K] = std::current_exception();
+                state.cancelled.store(true, std::memory_order_relaxed);
+            }
+            target.close();
+        }
+
+        template<typename Input, typename InputIt, typename OutputIt, std::size_t ... Ks>
+        static OutputIt run_stages(InputIt first, InputIt last, OutputIt out, std::index_sequence<Ks ...>)
+        {
+            auto queues = std::make_tuple(std::make_unique<queue<typename output_of<Input, Ks>::type>>() ...);
+            control state;
+            std::array<std::thread, stage_count> threads;
+            // The threads are joined before any exception leaves, whether it comes from a stage, from writing
+            // the results or from starting a thread.
+            auto finish = [&threads, &state](bool cancel)
+            {
+                if (cancel)
+                    state.cancelled.store(true, std::memory_order_relaxed);
+                for (std::thread &t : threads)
+                    if (t.joinable())
+                        t.join();
+            };
+            try
+            {
+                ((threads[Ks] = std::thread([&queues, &state, first, last] { stage_thread<Input, Ks>(queues, state, first, last); })), ...);
+
+                using result_type = typename output_of<Input, stage_count - 1>::type;
+                std::vector<result_type> results(Batch);
+                while (std::size_t count = pop_some(*std::get<stage_count - 1>(queues), results.data(), state, [] {}))
+                    for (std::size_t i = 0; i < count; ++i)
+                        *out++ = std::move(results[i]);
+            }
+            catch (...)
+            {
+                finish(true);
+                throw;
+            }
+            finish(false);
+            for (const std::exception_ptr &error : state.errors)
+                if (error)
+                    std::rethrow_exception(error);
+            return out;
+        }
+    }; // struct basic_pipeline
+
+    /**
+     * A pipeline with 1024-item queues and batches of up to 64 items.
+     *
+     * @tparam Stages               The stages, default constructible functors taking the output of the previous stage.
+     */
+    template<typename ... Stages>
+    using pipeline = basic_pipeline<1024, 64, Stages ...>;
+} // namespace ctl
+#endif //CTL_PIPELINE_H
@@ -0,0 +1,178 @@
+#ifndef CTL_POLY_H
+#define CTL_POLY_H
+
+#include <array>
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+#include "loops.h"
+/**
+ * poly - Evaluation of polynomials with constant coefficients, expanded at compile-time.
+ */
+
+namespace ctl
+{
+    /**
+     * The evaluation schemes of ctl::poly.
+     * horner - the fewest operations, but each one depends on the previous one.
+     * estrin - pairs of terms combined in a tree, so independent multiply-adds can run in parallel.
+     */
+    enum class poly_scheme
+    {
+        horner,
+        estrin
+    };
+
+    /**
+     * Struct used to evaluate c0 + c1 * x + ... + cn * x^n for constant coefficients.
+     * The argument can be a floating-point scalar or a GCC/Clang vector type, evaluated lane by lane.
+     * The coefficients are converted to the element type of the argument once, at compile-time.
+     *
+     * @tparam Coeffs               The coefficients, as std::ratio types, starting with the constant term.
+     */
+    template<typename ... Coeffs>
+    struct poly
+    {
+        static_assert(sizeof...(Coeffs) > 0, "[ctl::poly]: at least one coefficient is required");
+
+        poly() = delete;
+
+        static constexpr std::size_t degree = sizeof...(Coeffs) - 1;
+
+    private:
+        template<typename V, typename = void>
+        struct element
+        {
+            using type = V;
+        };
+
+        template<typename V>
+        struct element<V, std::enable_if_t<!std::is_arithmetic_v<V>>>
+        {
+            using type = std::decay_t<decltype(std::declval<V &>()[0])>;
+        };
+
+    public:
+        /**
+         * The element type of an argument, the argument itself for scalars or the lane type for vectors.
+         */
+        template<typename V>
+        using element_type = typename element<V>::type;
+
+        /**
+         * The coefficients, converted to E.
+         */
+        template<typename E>
+        static constexpr std::array<E, degree + 1> coefficients{static_cast<E>(Coeffs::num) / static_cast<E>(Coeffs::den) ...};
+
+        /**
+         * Static method used to evaluate the polynomial with Horner's scheme.
+         *
+         * @param x                 The argument.
+         * @return                  The value of the polynomial at x.
+         */
+        template<typename V>
+        static constexpr V horner(V x) noexcept
+        {
+            V result = V{} + coefficients<element_type<V>>[degree];
+            for_each_in<reversed<std::make_index_sequence<degree>>>::template begin<horner_step<V>::template action>(result, x);
+            return result;
+        }
+
+        /**
+         * Static method used to evaluate the polynomial with Estrin's scheme.
+         * The terms are split in halves of power of two length, joined by the matching power x^(2^k).
+         *
+         * @param x                 The argument.
+         * @return                  The value of the polynomial at x.
+         */
+        template<typename V>
+        static constexpr V estrin(V x) noexcept
+        {
+            std::array<V, power_count> powers{x};
+            for (std::size_t k = 1; k < power_count; ++k)
+                powers[k] = powers[k - 1] * powers[k - 1];
+            return estrin_range<V, 0, degree + 1>(x, powers);
+        }
+
+        /**
+         * Static method used to evaluate the polynomial with the scheme chosen at the call site.
+         *
+         * @tparam scheme           The evaluation scheme.
+         * @param x                 The argument.
+         * @return                  The value of the polynomial at x.
+         */
+        template<poly_scheme scheme = poly_scheme::horner, typename V>
+        static constexpr V evaluate(V x) noexcept
+        {
+            if constexpr (scheme == poly_scheme::estrin)
+                return estrin(x);
+            else
+                return horner(x);
+        }
+
+    private:
+        template<typename Sequence>
+        struct reverse;
+
+        template<std::size_t ... Is>
+        struct reverse<std::index_sequence<Is ...>>
+        {
+            using type = std::index_sequence<(sizeof...(Is) - 1 - Is) ...>;
+        };
+
+        template<typename Sequence>
+        using reversed = typename reverse<Sequence>::type;
+
+        template<typename V>
+        struct horner_step
+        {
+            template<std::size_t K>
+            struct action
+            {
+                constexpr void operator()(V &result, const V &x) const noexcept
+                {
+                    result = result * x + coefficients<element_type<V>>[K];
+                }
+            };
+        };
+
+        // The number of powers x^(2^k) used by the Estrin tree, at least one so that the table is never empty.
+        static constexpr std::size_t power_count = []
+        {
+            std::size_t count = 1;
+            while ((std::size_t{1} << count) < degree + 1)
+                ++count;
+            return count;
+        }();
+
+        /**
+         * Helper static method that evaluates the terms [Lo, Lo + Count) divided by x^Lo.
+         */
+        template<typename V, std::size_t Lo, std::size_t Count>
+        static constexpr V estrin_range(const V &x, const std::array<V, power_count> &powers) noexcept
+        {
+            if constexpr (Count == 1)
+                return V{} + coefficients<element_type<V>>[Lo];
+            else if constexpr (Count == 2)
+                return coefficients<element_type<V>>[Lo] + x * coefficients<element_type<V>>[Lo + 1];
+            else
+            {
+                constexpr std::size_t level = half_level(Count);
+                constexpr std::size_t half = std::size_t{1} << level;
+                return estrin_range<V, Lo, half>(x, powers) + powers[level] * estrin_range<V, Lo + half, Count - half>(x, powers);
+            }
+        }
+
+        // The exponent of the largest power of two less than count.
+        static constexpr std::size_t half_level(std::size_t count) noexcept
+        {
+            std::size_t level = 0;
+            while ((std::size_t{2} << level) < count)
+                ++level;
+            return level;
+        }
+    }; // struct poly
+} // namespace ctl
+#endif //CTL_POLY_H
@@ -0,0 +1,165 @@
+#ifndef CTL_PREFETCH_H
+#define CTL_PREFETCH_H
+
+#include <cstddef>
+#include "functors.h"
+#include "loops.h"
+/**
+ * prefetch - Loop adapters that issue software prefetches ahead of the loop body.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct used to walk an array while prefetching the element that will be needed Distance iterations later.
+     * Useful for access patterns the hardware prefetcher cannot predict (pointer-heavy or indirect accesses).
+     * When the trip count is known at compile-time, the _unrolled methods expand the loop with ctl::for_loop,
+     * so the bound of the prefetch is resolved at compile-time as well.
+     *
+     * @tparam Distance             How many iterations ahead of the body the prefetch is issued.
+     * @tparam Locality             The temporal locality hint passed to the prefetch (0 - none, 3 - keep in all caches).
+     */
+    template<std::size_t Distance, int Locality = 3>
+    struct prefetch_for
+    {
+        static_assert(Locality >= 0 && Locality <= 3, "[ctl::prefetch_for]: locality must be between 0 and 3");
+
+        prefetch_for() = delete;
+
+        /**
+         * Static method used to issue a read prefetch for some address.
+         * Compiles to nothing on compilers without __builtin_prefetch.
+         *
+         * @param addr              The address to be prefetched.
+         */
+        static inline void prefetch(const void *addr) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(addr, 0, Locality);
+#else
+            (void) addr;
+#endif
+        }
+
+        /**
+         * Static method used to start the loop over data[0] ... data[n - 1].
+         * The loop is split so that the tail (the last Distance iterations) does not test the prefetch bound.
+         *
+         * @param data              Pointer to the first element.
+         * @param n                 The number of elements.
+         * @param body              A callable invoked with a reference to each element.
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<typename E, typename F>
+        static bool begin(E *data, std::size_t n, F &&body)
+        {
+            std::size_t i = 0;
+            for (; i + Distance < n; ++i)
+            {
+                prefetch(data + i + Distance);
+                body(data[i]);
+            }
+            for (; i < n; ++i)
+                body(data[i]);
+            return n != 0;
+        }
+
+        /**
+         * Static method used to start a gather-style loop over data[indices[0]] ... data[indices[n - 1]].
+         * The prefetch goes through the index array, so the element is fetched before the body needs it.
+         *
+         * @param data              Pointer to the first element of the gathered array.
+         * @param indices           Pointer to the first element of the index array.
+         * @param n                 The number of indices.
+         * @param body              A callable invoked with a reference to each gathered element.
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<typename E, typename Index, typename F>
+        static bool begin_indirect(E *data, const Index *indices, std::size_t n, F &&body)
+        {
+            std::size_t i = 0;
+            for (; i + Distance < n; ++i)
+            {
+                prefetch(data + indices[i + Distance]);
+                body(data[indices[i]]);
+            }
+            for (; i < n; ++i)
+                body(data[indices[i]]);
+            return n != 0;
+        }
+
+        /**
+         * Static method used to start the loop over data[0] ... data[N - 1], unrolled at compile-time.
+         * The last Distance iterations issue no prefetch, without testing for it. The expansion is inlined,
+         * so N is bounded by -ftemplate-depth.
+         *
+         * @tparam N                The number of elements.
+         * @param data              Pointer to the first element.
+         * @param body              A callable invoked with a reference to each element.
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<std::size_t N, typename E, typename F>
+        static bool begin_unrolled(E *data, F &&body)
+        {
+            return for_loop<std::size_t, 0, N,
+                    functors<std::size_t>::update_functors<1>::inc,
+                    functors<std::size_t>::less_than,
+                    unrolled<N>::template step,
+                    expansion_mode::inlined>::begin(data, body);
+        }
+
+        /**
+         * Static method used to start a gather-style loop over data[indices[0]] ... data[indices[N - 1]], unrolled at compile-time.
+         * The last Distance iterations issue no prefetch, without testing for it. The expansion is inlined,
+         * so N is bounded by -ftemplate-depth.
+         *
+         * @tparam N                The number of indices.
+         * @param data              Pointer to the first element of the gathered array.
+         * @param indices           Pointer to the first element of the index array.
+         * @param body              A callable invoked with a reference to each gathered element.
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<std::size_t N, typename E, typename Index, typename F>
+        static bool begin_indirect_unrolled(E *data, const Index *indices, F &&body)
+        {
+            return for_loop<std::size_t, 0, N,
+                    functors<std::size_t>::update_functors<1>::inc,
+                    functors<std::size_t>::less_than,
+                    unrolled<N>::template indirect_step,
+                    expansion_mode::inlined>::begin(data, indices, body);
+        }
+
+    private:
+        /**
+         * Helper struct holding the action functors of the unrolled loops over N elements.
+         */
+        template<std::size_t N>
+        struct unrolled
+        {
+            template<std::size_t I>
+            struct step
+            {
+                template<typename E, typename F>
+                void operator()(E *&data, F &body) const
+                {
+                    if constexpr (I + Distance < N)
+                        prefetch(data + I + Distance);
+                    body(data[I]);
+                }
+            };
+
+            template<std::size_t I>
+            struct indirect_step
+            {
+                template<typename E, typename Index, typename F>
+                void operator()(E *&data, const Index *&indices, F &body) const
+                {
+                    if constexpr (I + Distance < N)
+                        prefetch(data + indices[I + Distance]);
+                    body(data[indices[I]]);
+                }
+            };
+        };
+    }; // struct prefetch_for
+} // namespace ctl
+#endif //CTL_PREFETCH_H
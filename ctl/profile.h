@@ -0,0 +1,350 @@
+#ifndef CTL_PROFILE_H
+#define CTL_PROFILE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "config.h"
+#include "iteration_space.h"
+#include "loops.h"
+#include "per_thread.h"
+#include "while_loop_trace.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif !defined(__x86_64__) && !defined(__i386__)
+#include <chrono>
+#endif
+/**
+ * profile - Opt-in per-iteration timing of loop actions, compiled out unless CTL_PROFILING is defined.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct collecting the time spent in each iteration of the profiled loops with the same tag.
+     * Every thread records into its own storage without locks; a lock is only taken when a thread
+     * records for the first time and when the results are exported.
+     * Samples are kept by the position of the iteration in its loop, so repeated runs of a loop add up per iteration.
+     *
+     * @tparam Tag                  A type used to keep the results of different loops apart.
+     */
+    template<typename Tag = void>
+    struct profiler
+    {
+        profiler() = delete;
+
+        static constexpr std::size_t capacity = CTL_PROFILE_CAPACITY;
+
+        // Samples are counted in log2 buckets: bucket b holds durations in [2^b, 2^(b + 1)), the last bucket everything above.
+        static constexpr std::size_t bucket_count = 32;
+
+        /**
+         * Static method used to read the cycle counter (rdtsc on x86, nanoseconds elsewhere).
+         *
+         * @return                  The current value of the counter.
+         */
+        static std::uint64_t now() noexcept
+        {
+#if defined(_MSC_VER)
+            return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            return __builtin_ia32_rdtsc();
+#else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        /**
+         * Static method used to record the duration of an iteration, in the storage of the calling thread.
+         *
+         * @param iteration         The position of the iteration in its loop, positions past capacity share the last slot.
+         * @param ticks             The duration, in counter ticks.
+         */
+        static void record(std::size_t iteration, std::uint64_t ticks) noexcept
+        {
+            slot &target = threads().local().slots[iteration < capacity ? iteration : capacity - 1];
+            owner_add(target.count, std::uint64_t{1});
+            owner_add(target.total, ticks);
+            if (ticks < target.min.load(std::memory_order_relaxed))
+                target.min.store(ticks, std::memory_order_relaxed);
+            if (ticks > target.max.load(std::memory_order_relaxed))
+                target.max.store(ticks, std::memory_order_relaxed);
+            std::size_t bucket = 0;
+            for (std::uint64_t t = ticks; t > 1 && bucket + 1 < bucket_count; t >>= 1)
+                ++bucket;
+            owner_add(target.buckets[bucket], std::uint64_t{1});
+        }
+
+        /**
+         * The results of one iteration, merged over all threads.
+         */
+        struct summary
+        {
+            std::size_t iteration;
+            std::uint64_t count;
+            std::uint64_t total;
+            std::uint64_t min;
+            std::uint64_t max;
+            std::array<std::uint64_t, bucket_count> buckets;
+        };
+
+        /**
+         * Static method used to merge the results of all threads.
+         *
+         * @return                  The summaries of the iterations that were recorded at least once, in iteration order.
+         */
+        static std::vector<summary> collect()
+        {
+            std::vector<summary> merged(capacity);
+            for (std::size_t i = 0; i < capacity; ++i)
+                merged[i] = summary{i, 0, 0, ~std::uint64_t{0}, 0, {}};
+            threads().for_each([&merged](const storage &s)
+            {
+                for (std::size_t i = 0; i < capacity; ++i)
+                {
+                    const slot &source = s.slots[i];
+                    summary &target = merged[i];
+                    target.count += source.count.load(std::memory_order_relaxed);
+                    target.total += source.total.load(std::memory_order_relaxed);
+                    std::uint64_t min = source.min.load(std::memory_order_relaxed);
+                    std::uint64_t max = source.max.load(std::memory_order_relaxed);
+                    target.min = min < target.min ? min : target.min;
+                    target.max = max > target.max ? max : target.max;
+                    for (std::size_t b = 0; b < bucket_count; ++b)
+                        target.buckets[b] += source.buckets[b].load(std::memory_order_relaxed);
+                }
+            });
+            std::vector<summary> result;
+            for (const summary &m : merged)
+                if (m.count)
+                    result.push_back(m);
+            return result;
+        }
+
+        /**
+         * Static method used to export the merged results as CSV, one row per iteration.
+         *
+         * @param os                The stream where the results are written.
+         */
+        static void write_csv(std::ostream &os)
+        {
+            os << "iteration,count,total,min,max,mean";
+            for (std::size_t b = 0; b < bucket_count; ++b)
+                os << ",bucket_" << b;
+            os << '\n';
+            for (const summary &s : collect())
+            {
+                os << s.iteration << ',' << s.count << ',' << s.total << ',' << s.min << ',' << s.max << ','
+                   << s.total / s.count;
+                for (std::uint64_t b : s.buckets)
+                    os << ',' << b;
+                os << '\n';
+            }
+        }
+
+        /**
+         * Static method used to export the merged results as a JSON array, one object per iteration.
+         *
+         * @param os                The stream where the results are written.
+         */
+        static void write_json(std::ostream &os)
+        {
+            os << '[';
+            const char *separator = "";
+            for (const summary &s : collect())
+            {
+                os << separator << "{\"iteration\":" << s.iteration << ",\"count\":" << s.count << ",\"total\":" << s.total
+                   << ",\"min\":" << s.min << ",\"max\":" << s.max << ",\"mean\":" << s.total / s.count << ",\"buckets\":[";
+                for (std::size_t b = 0; b < bucket_count; ++b)
+                    os << (b ? "," : "") << s.buckets[b];
+                os << "]}";
+                separator = ",";
+            }
+            os << "]\n";
+        }
+
+        /**
+         * Static method used to discard the results of all threads. Must not run concurrently with record.
+         */
+        static void reset()
+        {
+            threads().for_each([](storage &s)
+            {
+                for (slot &target : s.slots)
+                    target.clear();
+            });
+        }
+
+    private:
+        struct slot
+        {
+            std::atomic<std::uint64_t> count{0};
+            std::atomic<std::uint64_t> total{0};
+            std::atomic<std::uint64_t> min{~std::uint64_t{0}};
+            std::atomic<std::uint64_t> max{0};
+            std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+
+            void clear() noexcept
+            {
+                count.store(0, std::memory_order_relaxed);
+                total.store(0, std::memory_order_relaxed);
+                min.store(~std::uint64_t{0}, std::memory_order_relaxed);
+                max.store(0, std::memory_order_relaxed);
+                for (auto &b : buckets)
+                    b.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        struct storage
+        {
+            std::array<slot, capacity> slots;
+        };
+
+        // The storage outlives its thread, so that the results of finished threads can still be exported.
+        static per_thread_registry<storage> &threads()
+        {
+            static per_thread_registry<storage> instance;
+            return instance;
+        }
+    }; // struct profiler
+
+    /**
+     * Profiles a loop: the timed loop is derived from the loop type itself, so the two cannot drift apart.
+     * Only ctl::for_loop and ctl::while_loop are supported, see the specializations below.
+     *
+     * @tparam Loop                 The loop to be profiled.
+     * @tparam Tag                  The tag of the profiler that records the timings.
+     */
+    template<typename Loop, typename Tag = void>
+    struct profiled;
+
+    /**
+     * Wraps the action functor of a ctl::for_loop so that every call is timed by ctl::profiler<Tag>.
+     * Each call is recorded under the position of its iteration in the loop, found in the loop's iteration space:
+     *
+     *     ctl::profiled<ctl::for_loop<int, 0, 10, inc, less_than, action>>::begin();
+     *
+     * Without CTL_PROFILING, loop is the for_loop itself.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam I                    The starting value of the iterator.
+     * @tparam N                    The value at which the iterator stops.
+     * @tparam update_functor       A functor used to update the iterator on each iteration.
+     * @tparam conditional_functor  A functor used to verify if the loop is still running.
+     * @tparam action_functor       The functor to be profiled.
+     * @tparam mode                 How the iterations are expanded.
+     * @tparam Tag                  The tag of the profiler that records the timings.
+     */
+    template<typename T,
+            T I,
+            T N,
+            template<T> typename update_functor,
+            template<T, T> typename conditional_functor,
+            template<T> typename action_functor,
+            expansion_mode mode,
+            typename Tag>
+    struct profiled<for_loop<T, I, N, update_functor, conditional_functor, action_functor, mode>, Tag>
+    {
+        profiled() = delete;
+
+        using space = typename for_loop<T, I, N, update_functor, conditional_functor, action_functor, mode>::space;
+
+#ifdef CTL_PROFILING
+        template<T V>
+        struct instance
+        {
+            static constexpr std::size_t iteration = space::index_of(V);
+
+            static_assert(iteration < space::size, "[ctl::profiled]: the iterator value is not part of the iteration space");
+
+            template<typename ... Params>
+            void operator()(Params & ... params) const noexcept
+            {
+                std::uint64_t start = profiler<Tag>::now();
+                action_functor<V>{}(params ...);
+                profiler<Tag>::record(iteration, profiler<Tag>::now() - start);
+            }
+        };
+#else
+        template<T V>
+        using instance = action_functor<V>;
+#endif
+
+        /**
+         * The for_loop with the timed action.
+         */
+        using loop = for_loop<T, I, N, update_functor, conditional_functor, instance, mode>;
+
+        /**
+         * Static method used to start the timed loop, see ctl::for_loop::begin.
+         */
+        template<typename ... Params>
+        static bool begin(Params && ... params) noexcept
+        {
+            return loop::begin(params ...);
+        }
+    }; // struct profiled
+
+    /**
+     * Wraps the action functor of a ctl::while_loop so that every call is timed by ctl::profiler<Tag>.
+     * Each call is recorded under the position of its state in the loop, found in the loop's trace:
+     *
+     *     ctl::profiled<ctl::while_loop<int, condition, action, 0, 1>>::begin();
+     *
+     * Without CTL_PROFILING, loop is the while_loop itself.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam conditional_functor  A functor used to verify if the loop is still running.
+     * @tparam action_functor       The functor to be profiled.
+     * @tparam Args                 A pack of template arguments that represents the initial values of all loop parameters.
+     * @tparam Tag                  The tag of the profiler that records the timings.
+     */
+    template<typename T,
+            template<T ...> typename conditional_functor,
+            template<T ...> typename action_functor,
+            T ... Args,
+            typename Tag>
+    struct profiled<while_loop<T, conditional_functor, action_functor, Args ...>, Tag>
+    {
+        profiled() = delete;
+
+        using trace = while_loop_trace<T, conditional_functor, action_functor, Args ...>;
+
+#ifdef CTL_PROFILING
+        template<T ... States>
+        struct instance
+        {
+            static constexpr std::size_t iteration = trace::index_of(typename trace::state_type{States ...});
+
+            auto operator()() const noexcept
+            {
+                std::uint64_t start = profiler<Tag>::now();
+                auto next = action_functor<States ...>{}();
+                profiler<Tag>::record(iteration, profiler<Tag>::now() - start);
+                return next;
+            }
+        };
+#else
+        template<T ... States>
+        using instance = action_functor<States ...>;
+#endif
+
+        /**
+         * The while_loop with the timed action.
+         */
+        using loop = while_loop<T, conditional_functor, instance, Args ...>;
+
+        /**
+         * Static method used to start the timed loop, see ctl::while_loop::begin.
+         */
+        static bool begin() noexcept
+        {
+            return loop::begin();
+        }
+    }; // struct profiled
+} // namespace ctl
+#endif //CTL_PROFILE_H
@@ -0,0 +1,183 @@
+#ifndef CTL_SEARCH_H
+#define CTL_SEARCH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "functors.h"
+#include "loops.h"
+#include "prefetch.h"
+/**
+ * search - Branchless searches over small sorted tables, unrolled or laid out at compile-time.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct used to find the first element of a sorted array of N elements that is not less than a key.
+     * The halving steps of the search are a ctl::for_loop over the remaining length, so the search is fully unrolled,
+     * and each step moves to the next range by adding the result of the comparison, without a branch.
+     *
+     * @tparam N                    The number of elements.
+     */
+    template<std::size_t N>
+    struct static_lower_bound
+    {
+        static_lower_bound() = delete;
+
+        /**
+         * Static method used to search the array.
+         *
+         * @param data              Pointer to the N elements, sorted with respect to comp.
+         * @param key               The value searched for.
+         * @param comp              The comparison the elements are sorted with.
+         * @return                  The index of the first element that is not less than key, or N if there is none.
+         */
+        template<typename T, typename Compare = std::less<>>
+        static constexpr std::size_t find(const T *data, const T &key, Compare comp = {}) noexcept
+        {
+            if constexpr (N == 0)
+                return 0;
+            else
+            {
+                const T *base = data;
+                for_loop<std::size_t, N, 1, halve, functors<std::size_t>::template greater_than,
+                        steps<T, Compare>::template step, expansion_mode::inlined>::begin(base, key, comp);
+                return static_cast<std::size_t>(base - data) + comp(*base, key);
+            }
+        }
+
+        template<typename T, typename Compare = std::less<>>
+        static constexpr std::size_t find(const std::array<T, N> &data, const T &key, Compare comp = {}) noexcept
+        {
+            return find(data.data(), key, comp);
+        }
+
+    private:
+        // Each step drops the lower or the upper half of the remaining Length elements.
+        template<std::size_t Length>
+        struct halve
+        {
+            constexpr std::size_t operator()() const noexcept
+            {
+                return Length - Length / 2;
+            }
+        };
+
+        template<typename T, typename Compare>
+        struct steps
+        {
+            template<std::size_t Length>
+            struct step
+            {
+                constexpr void operator()(const T *&base, const T &key, Compare &comp) const noexcept
+                {
+                    // Written as arithmetic, GCC turns the equivalent conditional expression into a branch.
+                    base += static_cast<std::size_t>(comp(base[Length / 2], key)) * (Length / 2);
+                }
+            };
+        };
+    }; // struct static_lower_bound
+
+    /**
+     * Struct holding a sorted array in Eytzinger (breadth-first) order, where the children of node k are 2k and 2k + 1.
+     * The layout is built by the constexpr constructor, so a table declared constexpr is converted at compile-time.
+     * A search walks down the tree without branches, and prefetches the nodes four levels below the current one,
+     * which share a cache line, so that the memory latency of the deep levels overlaps with the comparisons.
+     *
+     * @tparam T                    The type of the elements.
+     * @tparam N                    The number of elements.
+     * @tparam Compare              The comparison the elements are sorted with.
+     */
+    template<typename T, std::size_t N, typename Compare = std::less<>>
+    struct eytzinger
+    {
+        /**
+         * The elements in Eytzinger order, starting at index 1.
+         */
+        std::array<T, N + 1> values{};
+
+        /**
+         * The position in the sorted array of each element of values.
+         */
+        std::array<std::size_t, N + 1> rank{};
+
+        /**
+         * @param sorted            The elements, sorted with respect to Compare.
+         */
+        constexpr explicit eytzinger(const std::array<T, N> &sorted) : values(), rank()
+        {
+            // In-order traversal of the implicit tree, without recursion, starting from its leftmost node.
+            std::size_t k = 1;
+            while (2 * k <= N)
+                k *= 2;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                values[k] = sorted[i];
+                rank[k] = i;
+                // The successor is the leftmost node of the right subtree, or the first ancestor reached from its left.
+                if (2 * k + 1 <= N)
+                {
+                    k = 2 * k + 1;
+                    while (2 * k <= N)
+                        k *= 2;
+                }
+                else
+                {
+                    while (k & 1)
+                        k >>= 1;
+                    k >>= 1;
+                }
+            }
+        }
+
+        /**
+         * Method used to search the table.
+         *
+         * @param key               The value searched for.
+         * @return                  The index in the sorted array of the first element that is not less than key, or N if there is none.
+         */
+        constexpr std::size_t lower_bound(const T &key) const noexcept
+        {
+            Compare comp{};
+            std::size_t k = 1;
+            while (k <= N)
+            {
+                if (!is_constant_evaluated())
+                    prefetch_for<0>::prefetch(reinterpret_cast<const void *>(
+                            reinterpret_cast<std::uintptr_t>(values.data()) + k * prefetch_stride * sizeof(T)));
+                k = 2 * k + comp(values[k], key);
+            }
+            // The answer is the last node where the search went left: drop the trailing right turns and that left turn.
+            k >>= trailing_ones(k) + 1;
+            return k ? rank[k] : N;
+        }
+
+    private:
+        // The number of elements in a cache line, the descendants of k at that depth start at k * prefetch_stride.
+        static constexpr std::size_t prefetch_stride = 64 / sizeof(T) ? 64 / sizeof(T) : 1;
+
+        static constexpr bool is_constant_evaluated() noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_is_constant_evaluated();
+#else
+            return false;
+#endif
+        }
+
+        static constexpr std::size_t trailing_ones(std::size_t k) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+            std::size_t count = 0;
+            for (; k & 1; k >>= 1)
+                ++count;
+            return count;
+#endif
+        }
+    }; // struct eytzinger
+} // namespace ctl
+#endif //CTL_SEARCH_H
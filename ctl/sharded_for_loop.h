@@ -0,0 +1,76 @@
+#ifndef CTL_SHARDED_FOR_LOOP_H
+#define CTL_SHARDED_FOR_LOOP_H
+
+#include <cstddef>
+#include <utility>
+#include "loops.h"
+/**
+ * sharded_for_loop - Compile-time for loops split into shards that are instantiated in separate translation units.
+ *
+ * This header only declares the shards, so including it does not expand any action.
+ * Each shard is explicitly instantiated in its own translation unit, which includes ctl/sharded_for_loop_impl.h
+ * (the ctl_add_sharded_loop function in cmake/CtlShards.cmake generates these translation units).
+ */
+
+namespace ctl
+{
+    /**
+     * Struct used to expand a for loop whose iterations are partitioned into contiguous shards.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam I                    The starting value of the iterator.
+     * @tparam N                    The value at which the iterator stops.
+     * @tparam update_functor       A functor used to update the iterator on each iteration.
+     * @tparam conditional_functor  A functor used to verify if the loop is still running.
+     * @tparam action_functor       A functor that performs the action on each iteration.
+     * @tparam Shards               The number of shards.
+     */
+    template<typename T,
+            T I,
+            T N,
+            template<T> typename update_functor,
+            template<T, T> typename conditional_functor,
+            template<T> typename action_functor,
+            std::size_t Shards>
+    struct sharded_for_loop
+    {
+        static_assert(Shards > 0, "[ctl::sharded_for_loop]: at least one shard is required");
+
+        sharded_for_loop() = delete;
+
+        using space = iteration_space<T, I, N, update_functor, conditional_functor>;
+
+        static constexpr std::size_t shard_count = Shards;
+        static constexpr std::size_t shard_size = (space::size + Shards - 1) / Shards;
+
+        /**
+         * Static method that performs the iterations of one shard, defined in ctl/sharded_for_loop_impl.h.
+         *
+         * @tparam K                The index of the shard.
+         */
+        template<std::size_t K>
+        static void shard() noexcept;
+
+        /**
+         * Static method used to start the loop, running the shards in order.
+         *
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        static bool begin() noexcept
+        {
+            run_shards(std::make_index_sequence<Shards>{});
+            return space::size != 0;
+        }
+
+    private:
+        template<std::size_t ... Ks>
+        static void run_shards(std::index_sequence<Ks ...>) noexcept
+        {
+            (shard<Ks>(), ...);
+        }
+
+        template<std::size_t Offset, std::size_t ... Is>
+        static void run_range(std::index_sequence<Is ...>) noexcept;
+    }; // struct sharded_for_loop
+} // namespace ctl
+#endif //CTL_SHARDED_FOR_LOOP_H
@@ -0,0 +1,50 @@
+#ifndef CTL_SHARDED_FOR_LOOP_IMPL_H
+#define CTL_SHARDED_FOR_LOOP_IMPL_H
+
+#include "sharded_for_loop.h"
+/**
+ * sharded_for_loop_impl - Definitions of the shards of ctl::sharded_for_loop.
+ * Only the translation units that instantiate the shards should include this header.
+ */
+
+namespace ctl
+{
+    template<typename T,
+            T I,
+            T N,
+            template<T> typename update_functor,
+            template<T, T> typename conditional_functor,
+            template<T> typename action_functor,
+            std::size_t Shards>
+    template<std::size_t K>
+    void sharded_for_loop<T, I, N, update_functor, conditional_functor, action_functor, Shards>::shard() noexcept
+    {
+        static_assert(K < Shards, "[ctl::sharded_for_loop]: shard index out of range");
+        constexpr std::size_t first = K * shard_size < space::size ? K * shard_size : space::size;
+        constexpr std::size_t last = first + shard_size < space::size ? first + shard_size : space::size;
+        run_range<first>(std::make_index_sequence<last - first>{});
+    }
+
+    template<typename T,
+            T I,
+            T N,
+            template<T> typename update_functor,
+            template<T, T> typename conditional_functor,
+            template<T> typename action_functor,
+            std::size_t Shards>
+    template<std::size_t Offset, std::size_t ... Is>
+    void sharded_for_loop<T, I, N, update_functor, conditional_functor, action_functor, Shards>::run_range(
+            std::index_sequence<Is ...>) noexcept
+    {
+        (action_functor<space::values[Offset + Is]>{}(), ...);
+    }
+} // namespace ctl
+
+/**
+ * Explicitly instantiates one shard of a ctl::sharded_for_loop.
+ *
+ * @param K                     The index of the shard.
+ * @param ...                   The sharded_for_loop type (or an alias of it).
+ */
+#define CTL_INSTANTIATE_SHARD(K, ...) template void __VA_ARGS__::shard<K>() noexcept;
+#endif //CTL_SHARDED_FOR_LOOP_IMPL_H
@@ -0,0 +1,246 @@
+#ifndef CTL_SIZE_CLASSES_H
+#define CTL_SIZE_CLASSES_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+#include "functors.h"
+#include "iteration_space.h"
+/**
+ * size_classes - Geometric allocation size classes generated at compile-time, and a pool allocator built on them.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct holding the size classes Min, Min * Factor, Min * Factor^2, ... up to Max, which is always the last class.
+     * The sequence is the iteration space of a for loop updated by functors::update_functors<Factor>::mul.
+     *
+     * @tparam Min                  The smallest size class.
+     * @tparam Max                  The largest size class.
+     * @tparam Factor               The ratio between two consecutive classes.
+     */
+    template<std::size_t Min, std::size_t Max, std::size_t Factor = 2>
+    struct size_classes
+    {
+        static_assert(Min > 0 && Min <= Max, "[ctl::size_classes]: the classes must satisfy 0 < Min <= Max");
+        static_assert(Factor > 1, "[ctl::size_classes]: the factor must be greater than 1");
+
+        size_classes() = delete;
+
+        using space = iteration_space<std::size_t, Min, Max,
+                functors<std::size_t>::template update_functors<Factor>::template mul,
+                functors<std::size_t>::template less_than>;
+
+        /**
+         * The number of classes.
+         */
+        static constexpr std::size_t size = space::size + 1;
+
+        /**
+         * The class sizes, in increasing order.
+         */
+        static constexpr std::array<std::size_t, size> values = []
+        {
+            std::array<std::size_t, size> result{};
+            for (std::size_t i = 0; i < space::size; ++i)
+                result[i] = space::values[i];
+            result[size - 1] = Max;
+            return result;
+        }();
+
+        /**
+         * Static method used to find the smallest class that fits a size.
+         * The classes are compared all at once and the results are added up, so there is no branch to mispredict.
+         *
+         * @param n                 The requested size, at most Max.
+         * @return                  The index of the class, or size if n is greater than Max.
+         */
+        static constexpr std::size_t class_of(std::size_t n) noexcept
+        {
+            return count_below(n, std::make_index_sequence<size>{});
+        }
+
+    private:
+        template<std::size_t ... Is>
+        static constexpr std::size_t count_below(std::size_t n, std::index_sequence<Is ...>) noexcept
+        {
+            return (static_cast<std::size_t>(n > values[Is]) + ...);
+        }
+    }; // struct size_classes
+
+    /**
+     * Struct used to allocate blocks of the sizes of a ctl::size_classes from pools.
+     * Each thread keeps a cache of free blocks per class and only takes the lock of the shared pool
+     * to exchange Batch blocks at a time. Blocks are carved from slabs of SlabSize bytes that are never returned
+     * to the system; requests larger than the largest class go to operator new.
+     * Blocks are carved with the class sizes rounded up to alignof(std::max_align_t), so every block is aligned
+     * like the memory returned by operator new.
+     *
+     * @tparam Classes              The size classes, a ctl::size_classes.
+     * @tparam Batch                The number of blocks moved between a thread cache and the shared pool at once.
+     * @tparam SlabSize             The number of bytes requested from the system when the shared pool runs out.
+     */
+    template<typename Classes, std::size_t Batch = 32, std::size_t SlabSize = 64 * 1024>
+    struct pool_allocator
+    {
+        pool_allocator() = delete;
+
+        static constexpr std::size_t alignment = alignof(std::max_align_t);
+
+        /**
+         * The number of bytes taken by a block of each class, the class size rounded up to the alignment.
+         */
+        static constexpr std::array<std::size_t, Classes::size> block_sizes = []
+        {
+            std::array<std::size_t, Classes::size> result{};
+            for (std::size_t c = 0; c < Classes::size; ++c)
+                result[c] = (Classes::values[c] + alignment - 1) / alignment * alignment;
+            return result;
+        }();
+
+        static constexpr bool blocks_aligned = []
+        {
+            for (std::size_t size : block_sizes)
+                if (size % alignment != 0 || size < sizeof(void *))
+                    return false;
+            return true;
+        }();
+
+        static_assert(blocks_aligned, "[ctl::pool_allocator]: every block must be aligned and hold a pointer");
+        static_assert(block_sizes[Classes::size - 1] <= SlabSize, "[ctl::pool_allocator]: the largest class must fit in a slab");
+        static_assert(Batch > 0, "[ctl::pool_allocator]: the batch must not be empty");
+
+        /**
+         * Static method used to allocate a block.
+         *
+         * @param n                 The number of bytes.
+         * @return                  Pointer to a block of at least n bytes.
+         */
+        static void *allocate(std::size_t n)
+        {
+            std::size_t c = Classes::class_of(n);
+            if (c == Classes::size)
+                return ::operator new(n);
+            cache &local = thread_cache();
+            if (!local.free[c])
+                local.refill(c);
+            node *block = local.free[c];
+            local.free[c] = block->next;
+            --local.count[c];
+            return block;
+        }
+
+        /**
+         * Static method used to release a block.
+         *
+         * @param p                 Pointer returned by allocate.
+         * @param n                 The size that was passed to allocate.
+         */
+        static void deallocate(void *p, std::size_t n) noexcept
+        {
+            std::size_t c = Classes::class_of(n);
+            if (c == Classes::size)
+            {
+                ::operator delete(p);
+                return;
+            }
+            cache &local = thread_cache();
+            local.free[c] = new(p) node{local.free[c]};
+            if (++local.count[c] >= 2 * Batch)
+                local.release(c, Batch);
+        }
+
+    private:
+        struct node
+        {
+            node *next;
+        };
+
+        // The pool shared by all threads, holding free lists and the slabs the blocks were carved from.
+        struct central
+        {
+            std::mutex mutex;
+            std::array<node *, Classes::size> free{};
+            std::vector<std::unique_ptr<unsigned char[]>> slabs;
+
+            // Takes up to Batch blocks of class c, carving a new slab when the free list is empty.
+            std::pair<node *, std::size_t> take(std::size_t c)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!free[c])
+                {
+                    slabs.push_back(std::make_unique<unsigned char[]>(SlabSize));
+                    unsigned char *slab = slabs.back().get();
+                    // The slab comes from operator new[], so it is aligned for std::max_align_t like the block sizes.
+                    std::size_t block_size = block_sizes[c];
+                    for (std::size_t offset = SlabSize / block_size * block_size; offset != 0; offset -= block_size)
+                        free[c] = new(slab + offset - block_size) node{free[c]};
+                }
+                node *first = free[c], *last = first;
+                std::size_t count = 1;
+                for (; count < Batch && last->next; ++count)
+                    last = last->next;
+                free[c] = last->next;
+                last->next = nullptr;
+                return {first, count};
+            }
+
+            void give(std::size_t c, node *first, node *last)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                last->next = free[c];
+                free[c] = first;
+            }
+        };
+
+        struct cache
+        {
+            std::array<node *, Classes::size> free{};
+            std::array<std::size_t, Classes::size> count{};
+
+            void refill(std::size_t c)
+            {
+                auto [first, taken] = shared().take(c);
+                free[c] = first;
+                count[c] = taken;
+            }
+
+            // Returns the first n blocks of class c to the shared pool.
+            void release(std::size_t c, std::size_t n) noexcept
+            {
+                node *first = free[c], *last = first;
+                for (std::size_t i = 1; i < n; ++i)
+                    last = last->next;
+                free[c] = last->next;
+                count[c] -= n;
+                shared().give(c, first, last);
+            }
+
+            // The blocks cached by a thread go back to the shared pool when the thread exits.
+            ~cache()
+            {
+                for (std::size_t c = 0; c < Classes::size; ++c)
+                    if (count[c])
+                        release(c, count[c]);
+            }
+        };
+
+        static central &shared()
+        {
+            static central instance;
+            return instance;
+        }
+
+        static cache &thread_cache()
+        {
+            thread_local cache instance;
+            return instance;
+        }
+    }; // struct pool_allocator
+} // namespace ctl
+#endif //CTL_SIZE_CLASSES_H
@@ -0,0 +1,120 @@
+#ifndef CTL_TUNING_H
+#define CTL_TUNING_H
+
+#include <chrono>
+#include <cstddef>
+#include "functors.h"
+#include "loops.h"
+/**
+ * tuning - Per-kernel loop shapes, chosen by hand or generated by the autotuner (cmake/CtlAutotune.cmake).
+ */
+
+// While a kernel is being benchmarked, the autotuner passes the candidate shape through these macros.
+#ifndef CTL_AUTOTUNE_UNROLL
+#define CTL_AUTOTUNE_UNROLL 1
+#endif
+
+#ifndef CTL_AUTOTUNE_MODE
+#define CTL_AUTOTUNE_MODE ctl::expansion_mode::automatic
+#endif
+
+namespace ctl
+{
+    /**
+     * Trait holding the loop shape used for a kernel. Specializations are generated by the autotuner.
+     *
+     * @tparam Kernel               A tag type naming the kernel.
+     */
+    template<typename Kernel>
+    struct tuning
+    {
+        static constexpr std::size_t unroll_factor = CTL_AUTOTUNE_UNROLL;
+        static constexpr expansion_mode mode = CTL_AUTOTUNE_MODE;
+    };
+
+    /**
+     * Struct used to run a loop with a runtime trip count, unrolled by a constant factor.
+     * Each group of Factor iterations is expanded with ctl::for_loop, the remaining iterations run one by one.
+     *
+     * @tparam Factor               The number of iterations in each unrolled group.
+     * @tparam mode                 How each group is expanded.
+     */
+    template<std::size_t Factor, expansion_mode mode = expansion_mode::inlined>
+    struct unroll
+    {
+        static_assert(Factor > 0, "[ctl::unroll]: the unroll factor must be positive");
+
+        unroll() = delete;
+
+    private:
+        template<std::size_t J>
+        struct step
+        {
+            template<typename F>
+            void operator()(const std::size_t &base, F &body) const noexcept
+            {
+                body(base + J);
+            }
+        };
+
+    public:
+        /**
+         * Static method used to start the loop.
+         *
+         * @param n                 The number of iterations.
+         * @param body              A callable invoked with each index in [0, n).
+         * @return                  true if the loop has executed at least once, otherwise false.
+         */
+        template<typename F>
+        static bool begin(std::size_t n, F &&body) noexcept
+        {
+            std::size_t unrolled = n - n % Factor;
+            for (std::size_t i = 0; i < unrolled; i += Factor)
+                for_loop<std::size_t, 0, Factor,
+                        functors<std::size_t>::update_functors<1>::inc,
+                        functors<std::size_t>::less_than,
+                        step,
+                        mode>::begin(i, body);
+            for (std::size_t i = unrolled; i < n; ++i)
+                body(i);
+            return n != 0;
+        }
+    }; // struct unroll
+
+    /**
+     * The unrolled loop shape chosen for a kernel.
+     *
+     * @tparam Kernel               A tag type naming the kernel.
+     */
+    template<typename Kernel>
+    using tuned_unroll = unroll<tuning<Kernel>::unroll_factor,
+            tuning<Kernel>::mode == expansion_mode::outlined ? expansion_mode::outlined : expansion_mode::inlined>;
+
+    /**
+     * Function used by autotuner kernels to time themselves.
+     *
+     * @param kernel            A callable that runs the kernel once.
+     * @param repetitions       The number of timed runs.
+     * @return                  The fastest run, in nanoseconds.
+     */
+    template<typename F>
+    double measure_ns(F &&kernel, std::size_t repetitions = 20)
+    {
+        double best = 0;
+        for (std::size_t r = 0; r < repetitions; ++r)
+        {
+            auto start = std::chrono::steady_clock::now();
+            kernel();
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            if (r == 0 || elapsed.count() < best)
+                best = elapsed.count();
+        }
+        return best;
+    }
+} // namespace ctl
+
+// The header generated by the autotuner, holding the specializations of ctl::tuning.
+#ifdef CTL_TUNING_HEADER
+#include CTL_TUNING_HEADER
+#endif
+#endif //CTL_TUNING_H
@@ -2,6 +2,7 @@
 #define CTL_UTILS_H
 
 #include <iostream>
+#include "functors.h"
 /**
  * utils - Some commonly used functors for the ctl API.
  */
@@ -9,59 +10,13 @@
 namespace ctl
 {
     /**
-     * Wrapper struct containing helper functors.
+     * Wrapper struct containing helper functors, including the output functors that need <iostream>.
      *
      * @tparam T        The type used for the begin iterator.
      */
     template<typename T>
-    struct utils
+    struct utils : functors<T>
     {
-        /**
-         * Wrapper struct for functors that update the iterator.
-         *
-         * @tparam delta    The amount by which the iterator is changed.
-         */
-        template<T delta>
-        struct update_functors
-        {
-            template<T I>
-            struct inc
-            {
-                constexpr T operator()() const noexcept
-                {
-                    return I + delta;
-                }
-            };
-
-            template<T I>
-            struct dec
-            {
-                constexpr T operator()() const noexcept
-                {
-                    return I - delta;
-                }
-            };
-
-            template<T I>
-            struct mul
-            {
-                constexpr T operator()() const noexcept
-                {
-                    return I * delta;
-                }
-            };
-
-            template<T I>
-            struct div
-            {
-                constexpr T operator()() const noexcept
-                {
-                    static_assert(delta != 0, "[ctl::utils::update_functors::div]: cannot divide by 0");
-                    return I / delta;
-                }
-            };
-        }; // struct update_functors
-
         /**
          * Wrapper struct for functors that output something.
          *
@@ -87,44 +42,6 @@ namespace ctl
                 }
             };
         }; // struct output_functors
-
-        // Conditional functors to test the loop condition.
-
-        template<T I, T N>
-        struct less_than
-        {
-            constexpr bool operator()() const noexcept
-            {
-                return I < N;
-            }
-        };
-
-        template<T I, T N>
-        struct greater_than
-        {
-            constexpr bool operator()() const noexcept
-            {
-                return I > N;
-            }
-        };
-
-        template<T I, T N>
-        struct equ
-        {
-            constexpr bool operator()() const noexcept
-            {
-                return I == N;
-            }
-        };
-
-        template<T I, T N>
-        struct not_equ
-        {
-            constexpr bool operator()() const noexcept
-            {
-                return I != N;
-            }
-        };
     }; // struct utils
 } // namespace ctl
 #endif //CTL_UTILS_H
@@ -0,0 +1,132 @@
+#ifndef CTL_WHILE_LOOP_TRACE_H
+#define CTL_WHILE_LOOP_TRACE_H
+
+#include <array>
+#include <cstddef>
+#include <utility>
+/**
+ * while_loop_trace - Records the states visited by a compile-time while loop as constexpr data.
+ */
+
+namespace ctl
+{
+    /**
+     * Struct used to record every state of a while loop at compile-time.
+     * The next state is taken from the return type of the action functor, so the actions are never called
+     * and their side effects (e.g. printing) do not happen.
+     *
+     * @tparam T                    The type used to iterate through the loop.
+     * @tparam conditional_functor  A functor used to verify if the loop is still running.
+     * @tparam action_functor       A functor that returns the next state as a std::integer_sequence.
+     * @tparam Args                 A pack of template arguments that represents the initial values of all loop parameters.
+     */
+    template<typename T,
+            template<T ...> typename conditional_functor,
+            template<T ...> typename action_functor,
+            T ... Args>
+    struct while_loop_trace
+    {
+        while_loop_trace() = delete;
+
+        using value_type = T;
+
+        /**
+         * The values of all loop parameters at some point of the loop.
+         */
+        using state_type = std::array<T, sizeof...(Args)>;
+
+    private:
+        template<T ... Ints>
+        static constexpr std::size_t count(std::integer_sequence<T, Ints ...> &&) noexcept
+        {
+            if constexpr (conditional_functor<Ints ...>{}())
+                return 1 + count(decltype(action_functor<Ints ...>{}()){});
+            else
+                return 0;
+        }
+
+        template<std::size_t Size, T ... Ints>
+        static constexpr state_type fill(std::array<state_type, Size> &states, std::size_t pos,
+                                         std::integer_sequence<T, Ints ...> &&) noexcept
+        {
+            if constexpr (conditional_functor<Ints ...>{}())
+            {
+                states[pos] = state_type{Ints ...};
+                return fill(states, pos + 1, decltype(action_functor<Ints ...>{}()){});
+            }
+            else
+                return state_type{Ints ...};
+        }
+
+    public:
+        /**
+         * The number of iterations of the loop.
+         */
+        static constexpr std::size_t size = count(std::integer_sequence<T, Args ...>{});
+
+    private:
+        struct trace
+        {
+            std::array<state_type, size> states;
+            state_type final_state;
+        };
+
+        static constexpr trace record() noexcept
+        {
+            trace result{};
+            result.final_state = fill(result.states, 0, std::integer_sequence<T, Args ...>{});
+            return result;
+        }
+
+        static constexpr trace recorded = record();
+
+        template<std::size_t K>
+        static constexpr std::array<T, size> project() noexcept
+        {
+            static_assert(K < sizeof...(Args), "[ctl::while_loop_trace]: component index out of range");
+            std::array<T, size> result{};
+            for (std::size_t i = 0; i < size; ++i)
+                result[i] = recorded.states[i][K];
+            return result;
+        }
+
+    public:
+        /**
+         * The states for which the action is performed, in the order in which the loop visits them.
+         */
+        static constexpr std::array<state_type, size> states = recorded.states;
+
+        /**
+         * The state for which the condition first fails.
+         */
+        static constexpr state_type final_state = recorded.final_state;
+
+        /**
+         * The values of a single loop parameter on each iteration.
+         *
+         * @tparam K                The position of the parameter in the state.
+         */
+        template<std::size_t K>
+        static constexpr std::array<T, size> component = project<K>();
+
+        /**
+         * Static method used to find the position of a state in the loop.
+         *
+         * @param state             The values of all loop parameters.
+         * @return                  The index of the iteration with that state, or size if the loop never reaches it.
+         */
+        static constexpr std::size_t index_of(const state_type &state) noexcept
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                bool equal = true;
+                for (std::size_t k = 0; k < sizeof...(Args); ++k)
+                    equal = equal && states[i][k] == state[k];
+                if (equal)
+                    return i;
+            }
+            return size;
+        }
+    }; // struct while_loop_trace
+} // namespace ctl
+#endif //CTL_WHILE_LOOP_TRACE_H
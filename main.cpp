@@ -54,6 +54,47 @@ struct condition
     }
 };
 
+// An int overflows after fib(46), a 256-bit ctl::big_int holds the terms up to fib(370)
+constexpr ctl::uint256 big_fib(unsigned n)
+{
+    ctl::uint256 a = 0, b = 1;
+    for (unsigned i = 0; i < n; ++i)
+    {
+        ctl::uint256 next = a + b;
+        a = b;
+        b = next;
+    }
+    return a;
+}
+
+// A sieve of Eratosthenes evaluated at compile-time, used as a predicate for ctl::make_bitset
+template<std::size_t Bound>
+struct sieve
+{
+    static constexpr std::array<bool, Bound> composite = []
+    {
+        std::array<bool, Bound> marks{};
+        for (std::size_t p = 2; p * p < Bound; ++p)
+            if (!marks[p])
+                for (std::size_t m = p * p; m < Bound; m += p)
+                    marks[m] = true;
+        return marks;
+    }();
+
+    template<std::size_t I>
+    struct is_prime
+    {
+        constexpr bool operator()() const noexcept
+        {
+            return I >= 2 && !composite[I];
+        }
+    };
+};
+
+// Size classes 16, 32, 64, 100 (not a multiple of the alignment) served by a pool allocator
+using small_classes = ctl::size_classes<16, 100>;
+using small_pool = ctl::pool_allocator<small_classes>;
+
 // A function used to illustrate the make_action_functor struct
 void print_something(int x)
 {
@@ -80,5 +121,33 @@ int main()
 
     std::cout << "\n\nAnd this is a do-while loop (the loop has a false starting condition):\n";
     ctl::while_loop<int, condition, action, 10000, 15000, 10000>::do_while_begin();
-}
 
+    // The same loop, recorded as constexpr data instead of printed (the action is never called here)
+    using fib_trace = ctl::while_loop_trace<int, condition, action, 0, 1, 10000>;
+    static_assert(fib_trace::final_state[0] == 10946);
+    std::cout << "\n\nThe " << fib_trace::size << " states of the while loop, recorded at compile-time:\n";
+    for (int value : fib_trace::component<0>)
+        std::cout << value << ' ';
+
+    constexpr auto fib_200 = big_fib(200).to_chars();
+    std::cout << "\n\nfib(200), computed at compile-time with a 256-bit integer:\n" << fib_200.data();
+
+    constexpr std::size_t prime_bound = 100;
+    using primes = ctl::make_bitset<prime_bound, sieve<prime_bound>::is_prime>;
+    std::cout << "\n\nThe " << primes::count() << " primes smaller than " << prime_bound << ", read from a compile-time bitset:\n";
+    for (std::size_t i = 0; i < primes::size(); ++i)
+        if (primes::test(i))
+            std::cout << i << ' ';
+
+    std::cout << "\n\nBlocks from a pool allocator with size classes";
+    for (std::size_t size : small_classes::values)
+        std::cout << ' ' << size;
+    std::cout << ":\n";
+    for (std::size_t n : {8, 24, 72, 100, 4096})
+    {
+        void *block = small_pool::allocate(n);
+        bool aligned = reinterpret_cast<std::uintptr_t>(block) % alignof(std::max_align_t) == 0;
+        std::cout << n << " bytes -> class " << small_classes::class_of(n) << (aligned ? ", aligned\n" : ", misaligned\n");
+        small_pool::deallocate(block, n);
+    }
+}
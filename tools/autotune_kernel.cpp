@@ -0,0 +1,25 @@
+// Example kernel for the autotuner (see cmake/CtlAutotune.cmake).
+// The autotuner compiles this file once per candidate loop shape and reads the time printed by main().
+#include <iostream>
+#include <vector>
+#include "ctl/tuning.h"
+
+// The tag naming the kernel in ctl::tuning.
+struct saxpy_kernel;
+
+int main()
+{
+    std::vector<float> x(1 << 16, 1.5f), y(1 << 16, 0.5f);
+    float a = 2.0f;
+    double ns = ctl::measure_ns([&]
+    {
+        ctl::tuned_unroll<saxpy_kernel>::begin(x.size(), [&](std::size_t i)
+        {
+            y[i] = a * x[i] + y[i];
+        });
+    });
+    // Keep the result observable so that the kernel is not optimized away.
+    volatile float sink = y[0];
+    (void) sink;
+    std::cout << static_cast<long long>(ns) << '\n';
+}
@@ -0,0 +1,97 @@
+# Compile-time benchmark for the ways of consuming ctl: including ctl.h, a precompiled ctl.h, and import ctl;.
+#
+# cmake -DCXX=<compiler> [-DTU_COUNT=<count>] [-DWORK_DIR=<dir>] -P tools/bench_compile_time.cmake
+#
+# Generates TU_COUNT (default 16) small translation units that use ctl, compiles them one after another in each
+# configuration and prints the total wall time. The PCH and module builds include the time spent building ctl.h.gch
+# and ctl.cppm once. The flags are those of GCC; the build target bench_compile_time runs this script with the
+# compiler of the project when CTL_BUILD_BENCHMARKS is on.
+
+cmake_minimum_required(VERSION 3.23)
+
+if(NOT CXX)
+    message(FATAL_ERROR "bench_compile_time: pass the compiler with -DCXX=<compiler>")
+endif()
+if(NOT TU_COUNT)
+    set(TU_COUNT 16)
+endif()
+if(NOT WORK_DIR)
+    set(WORK_DIR "${CMAKE_CURRENT_BINARY_DIR}/ctl_compile_time")
+endif()
+get_filename_component(ROOT_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+set(FLAGS -std=c++20 -O2)
+
+# Writes the translation units of one configuration, starting with the given line.
+function(write_sources DIR FIRST_LINE)
+    math(EXPR last "${TU_COUNT} - 1")
+    foreach(k RANGE 0 ${last})
+        string(CONFIGURE [=[
+@FIRST_LINE@
+
+namespace
+{
+    template<int I>
+    struct add
+    {
+        void operator()(long &sum) const noexcept
+        {
+            sum += I * @k@;
+        }
+    };
+}
+
+long tu_@k@()
+{
+    using f = ctl::functors<int>;
+    long sum = 0;
+    ctl::for_loop<int, 0, 32, f::update_functors<1>::inc, f::less_than, add>::begin(sum);
+    return sum + ctl::crc32::compute("ctl", 3);
+}
+]=] content @ONLY)
+        file(WRITE "${DIR}/tu_${k}.cpp" "${content}")
+    endforeach()
+endfunction()
+
+# Runs one compiler command in DIR, failing the benchmark if it does not succeed.
+function(compile DIR)
+    execute_process(COMMAND ${CXX} ${FLAGS} ${ARGN} WORKING_DIRECTORY "${DIR}" RESULT_VARIABLE result ERROR_VARIABLE error)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "bench_compile_time: ${CXX} ${ARGN} failed\n${error}")
+    endif()
+endfunction()
+
+# Compiles every translation unit of DIR after the optional SETUP command, and prints the times.
+function(measure NAME DIR)
+    cmake_parse_arguments(ARG "" "" "SETUP;OPTIONS" ${ARGN})
+    string(TIMESTAMP start "%s%f")
+    if(ARG_SETUP)
+        compile("${DIR}" ${ARG_SETUP})
+    endif()
+    string(TIMESTAMP setup_done "%s%f")
+    math(EXPR last "${TU_COUNT} - 1")
+    foreach(k RANGE 0 ${last})
+        compile("${DIR}" ${ARG_OPTIONS} -c tu_${k}.cpp -o tu_${k}.o)
+    endforeach()
+    string(TIMESTAMP stop "%s%f")
+    math(EXPR total "(${stop} - ${start}) / 1000")
+    math(EXPR setup "(${setup_done} - ${start}) / 1000")
+    math(EXPR per_unit "(${stop} - ${setup_done}) / 1000 / ${TU_COUNT}")
+    message(STATUS "${NAME}: ${total} ms for ${TU_COUNT} translation units (${setup} ms of setup, then ${per_unit} ms each)")
+endfunction()
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+foreach(config include pch module)
+    file(MAKE_DIRECTORY "${WORK_DIR}/${config}")
+endforeach()
+write_sources("${WORK_DIR}/include" "#include \"ctl.h\"")
+write_sources("${WORK_DIR}/pch" "#include \"ctl.h\"")
+write_sources("${WORK_DIR}/module" "import ctl;")
+
+measure("#include \"ctl.h\"" "${WORK_DIR}/include" OPTIONS -I${ROOT_DIR})
+# GCC looks for ctl.h.gch in each include directory before ctl.h, so the work directory is searched first.
+measure("precompiled ctl.h" "${WORK_DIR}/pch"
+        SETUP -I${ROOT_DIR} -x c++-header ${ROOT_DIR}/ctl.h -o ctl.h.gch
+        OPTIONS -I. -I${ROOT_DIR})
+measure("import ctl;" "${WORK_DIR}/module"
+        SETUP -fmodules-ts -I${ROOT_DIR} -x c++ -c ${ROOT_DIR}/ctl.cppm -o ctl.o
+        OPTIONS -fmodules-ts)
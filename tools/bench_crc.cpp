@@ -0,0 +1,45 @@
+// Benchmark for ctl::crc (built with -DCTL_BUILD_BENCHMARKS=ON).
+// Prints the throughput of CRC-32 with 1 to 16 slices, and of CRC-64, on a buffer that fits the L1 cache
+// and on one that does not.
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "ctl/crc.h"
+#include "ctl/tuning.h"
+
+namespace
+{
+    std::uint64_t sink = 0;
+
+    template<typename Crc>
+    void measure(const char *name, const std::vector<unsigned char> &buffer)
+    {
+        double ns = ctl::measure_ns([&]
+        {
+            sink += Crc::compute(buffer.data(), buffer.size());
+        });
+        std::cout << name << '\t' << buffer.size() << " bytes\t" << buffer.size() / ns << " GB/s\n";
+    }
+
+    template<std::size_t Slices>
+    using crc32_slices = ctl::crc<std::uint32_t, 0xEDB88320u, 0xFFFFFFFFu, 0xFFFFFFFFu, Slices>;
+}
+
+int main()
+{
+    for (std::size_t size : {std::size_t{16} << 10, std::size_t{64} << 20})
+    {
+        std::vector<unsigned char> buffer(size);
+        for (std::size_t i = 0; i < size; ++i)
+            buffer[i] = static_cast<unsigned char>(i * 131 + (i >> 7));
+        measure<crc32_slices<1>>("crc32 slice-by-1 ", buffer);
+        measure<crc32_slices<4>>("crc32 slice-by-4 ", buffer);
+        measure<crc32_slices<8>>("crc32 slice-by-8 ", buffer);
+        measure<crc32_slices<16>>("crc32 slice-by-16", buffer);
+        measure<ctl::crc64>("crc64 slice-by-8 ", buffer);
+    }
+
+    // Keep the checksums observable so that they are not optimized away.
+    volatile std::uint64_t result = sink;
+    (void) result;
+}
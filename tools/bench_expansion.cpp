@@ -0,0 +1,155 @@
+// Benchmark for the ctl::for_loop expansion modes (built with -DCTL_BUILD_BENCHMARKS=ON).
+// Times the same loop inlined and outlined at several sizes, once hot and once rotating through Variants copies
+// of it so that the inlined code no longer fits the instruction cache. On ELF systems it also reports the size of the
+// machine code of one copy (the functions of the loop, read from the symbol table of the executable), which is what
+// CTL_OUTLINE_THRESHOLD trades against the indirect call per iteration.
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(__linux__) && __has_include(<elf.h>) && __has_include(<cxxabi.h>)
+#define CTL_BENCH_CODE_SIZE 1
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <elf.h>
+#endif
+#include "ctl/functors.h"
+#include "ctl/loops.h"
+#include "ctl/tuning.h"
+
+namespace
+{
+    using f = ctl::functors<int>;
+
+    constexpr int variants = 8;
+    constexpr std::size_t calls = 200;
+
+    // An action with a few instructions of work, distinct per iteration and per copy of the loop.
+    template<int Variant>
+    struct mixer
+    {
+        template<int I>
+        struct action
+        {
+            void operator()(std::uint64_t *state) const noexcept
+            {
+                constexpr int k = I + Variant;
+                state[k % 8] = (state[k % 8] * (2 * k + 1)) ^ (state[(k + 3) % 8] >> (k % 13 + 1));
+            }
+        };
+    };
+
+    // The demangled names and sizes of the functions of this executable, empty where the symbol table cannot be read.
+    std::vector<std::pair<std::string, std::size_t>> functions()
+    {
+        std::vector<std::pair<std::string, std::size_t>> result;
+#ifdef CTL_BENCH_CODE_SIZE
+        std::ifstream file("/proc/self/exe", std::ios::binary);
+        std::vector<char> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (image.size() < sizeof(Elf64_Ehdr) || std::memcmp(image.data(), ELFMAG, SELFMAG) != 0 || image[EI_CLASS] != ELFCLASS64)
+            return result;
+        Elf64_Ehdr header;
+        std::memcpy(&header, image.data(), sizeof(header));
+        auto section = [&](std::size_t i)
+        {
+            Elf64_Shdr s;
+            std::memcpy(&s, image.data() + header.e_shoff + i * header.e_shentsize, sizeof(s));
+            return s;
+        };
+        for (std::size_t i = 0; i < header.e_shnum; ++i)
+        {
+            Elf64_Shdr symbols = section(i);
+            if (symbols.sh_type != SHT_SYMTAB)
+                continue;
+            Elf64_Shdr names = section(symbols.sh_link);
+            for (std::size_t k = 0; k < symbols.sh_size / sizeof(Elf64_Sym); ++k)
+            {
+                Elf64_Sym symbol;
+                std::memcpy(&symbol, image.data() + symbols.sh_offset + k * sizeof(Elf64_Sym), sizeof(symbol));
+                if (ELF64_ST_TYPE(symbol.st_info) != STT_FUNC || !symbol.st_size)
+                    continue;
+                int status = 0;
+                char *name = abi::__cxa_demangle(image.data() + names.sh_offset + symbol.st_name, nullptr, nullptr, &status);
+                if (status == 0)
+                    result.emplace_back(name, symbol.st_size);
+                std::free(name);
+            }
+        }
+#endif
+        return result;
+    }
+
+    // The bytes of machine code of the first copy of a loop: its kernel and the functions of the loop that were not inlined.
+    std::size_t code_size(ctl::expansion_mode mode, int n)
+    {
+        static const std::vector<std::pair<std::string, std::size_t>> all = functions();
+        std::string m = "(ctl::expansion_mode)" + std::to_string(static_cast<int>(mode));
+        std::string kernel = "kernel<" + m + ", " + std::to_string(n) + ", 0>(";
+        std::string loop = ", " + std::to_string(n) + ", ctl::functors<int>::update_functors<1>::inc, ";
+        std::string action = "mixer<0>::action, " + m + ">::";
+        std::size_t result = 0;
+        for (const auto &[name, size] : all)
+            if (name.find(kernel) != std::string::npos
+                || (name.find("ctl::for_loop<int, ") != std::string::npos && name.find(loop) != std::string::npos
+                    && name.find(action) != std::string::npos))
+                result += size;
+        return result;
+    }
+
+    template<ctl::expansion_mode Mode, int N, int Variant>
+    CTL_NOINLINE void kernel(std::uint64_t *state)
+    {
+        ctl::for_loop<int, 0, N, f::update_functors<1>::inc, f::less_than, mixer<Variant>::template action, Mode>::begin(state);
+    }
+
+    template<ctl::expansion_mode Mode, int N, int ... Variants>
+    void rotate(std::uint64_t *state)
+    {
+        (kernel<Mode, N, Variants>(state), ...);
+    }
+
+    template<ctl::expansion_mode Mode, int N>
+    void measure(const char *name)
+    {
+        std::uint64_t state[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+        double hot = ctl::measure_ns([&]
+        {
+            for (std::size_t c = 0; c < calls; ++c)
+                kernel<Mode, N, 0>(state);
+        });
+        double cold = ctl::measure_ns([&]
+        {
+            for (std::size_t c = 0; c < calls / variants; ++c)
+                rotate<Mode, N, 0, 1, 2, 3, 4, 5, 6, 7>(state);
+        });
+        std::cout << "N=" << N << '\t' << name << "\thot " << hot / (calls * N) << " ns/iteration"
+                  << "\trotating " << cold / (calls * N) << " ns/iteration";
+        if (std::size_t size = code_size(Mode, N))
+            std::cout << "\tcode " << size << " bytes";
+        std::cout << '\n';
+        // Keep the state observable so that the loops are not optimized away.
+        volatile std::uint64_t result = state[0];
+        (void) result;
+    }
+
+    template<int N>
+    void compare()
+    {
+        measure<ctl::expansion_mode::inlined, N>("inlined ");
+        measure<ctl::expansion_mode::outlined, N>("outlined");
+    }
+}
+
+int main()
+{
+    static_assert(variants == 8, "rotate lists eight variants");
+    compare<32>();
+    compare<128>();
+    compare<256>();
+    compare<512>();
+    std::cout << "automatic outlines loops over " << CTL_OUTLINE_THRESHOLD << " iterations\n";
+}
@@ -0,0 +1,108 @@
+// Benchmark for ctl::fft (built with -DCTL_BUILD_BENCHMARKS=ON).
+// Compares the forward transform against a textbook iterative radix-2 FFT with a precomputed twiddle table,
+// for sizes on both sides of CTL_FFT_UNROLL_LIMIT.
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <vector>
+#include "ctl/fft.h"
+#include "ctl/tuning.h"
+
+namespace
+{
+    using complex = std::complex<double>;
+
+    constexpr std::size_t points_per_run = std::size_t{1} << 16;
+    constexpr std::size_t repetitions = 200;
+
+    // Iterative in-place radix-2 FFT, the usual runtime implementation.
+    class iterative_fft
+    {
+    public:
+        explicit iterative_fft(std::size_t n) : n(n), twiddles(n / 2)
+        {
+            for (std::size_t k = 0; k < n / 2; ++k)
+                twiddles[k] = std::polar(1.0, -2 * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(n));
+        }
+
+        void forward(complex *data) const noexcept
+        {
+            for (std::size_t i = 1, j = 0; i < n; ++i)
+            {
+                std::size_t bit = n >> 1;
+                for (; j & bit; bit >>= 1)
+                    j ^= bit;
+                j ^= bit;
+                if (i < j)
+                    std::swap(data[i], data[j]);
+            }
+            for (std::size_t len = 2; len <= n; len <<= 1)
+                for (std::size_t base = 0; base < n; base += len)
+                    for (std::size_t k = 0; k < len / 2; ++k)
+                    {
+                        complex w = twiddles[k * (n / len)];
+                        complex a = data[base + k], b = data[base + k + len / 2];
+                        complex t(b.real() * w.real() - b.imag() * w.imag(), b.real() * w.imag() + b.imag() * w.real());
+                        data[base + k] = a + t;
+                        data[base + k + len / 2] = a - t;
+                    }
+        }
+
+    private:
+        std::size_t n;
+        std::vector<complex> twiddles;
+    };
+
+    double sink = 0;
+
+    template<std::size_t N>
+    void compare()
+    {
+        std::vector<complex> data(N);
+        for (std::size_t i = 0; i < N; ++i)
+            data[i] = complex(std::sin(0.37 * static_cast<double>(i)), std::cos(1.3 * static_cast<double>(i)));
+        constexpr std::size_t runs = points_per_run / N;
+
+        // Both transforms run in place on a fresh copy of the input, so the copy costs the same on both sides.
+        std::vector<complex> buffer(N);
+        double ctl_ns = ctl::measure_ns([&]
+        {
+            for (std::size_t r = 0; r < runs; ++r)
+            {
+                std::copy(data.begin(), data.end(), buffer.begin());
+                ctl::fft<N>::forward(buffer.data());
+                sink += buffer[1].real();
+            }
+        }, repetitions);
+
+        iterative_fft reference(N);
+        double iterative_ns = ctl::measure_ns([&]
+        {
+            for (std::size_t r = 0; r < runs; ++r)
+            {
+                std::copy(data.begin(), data.end(), buffer.begin());
+                reference.forward(buffer.data());
+                sink += buffer[1].real();
+            }
+        }, repetitions);
+
+        std::cout << "N=" << N << (ctl::fft<N>::unrolled ? " (unrolled)" : " (looped)  ") << "\tctl::fft "
+                  << ctl_ns / runs << " ns\titerative " << iterative_ns / runs << " ns\n";
+    }
+}
+
+int main()
+{
+    compare<8>();
+    compare<16>();
+    compare<64>();
+    compare<128>();
+    compare<256>();
+    compare<1024>();
+    compare<4096>();
+
+    // Keep the results observable so that the transforms are not optimized away.
+    volatile double result = sink;
+    (void) result;
+}
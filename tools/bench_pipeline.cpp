@@ -0,0 +1,116 @@
+// Benchmark for ctl::pipeline (built with -DCTL_BUILD_BENCHMARKS=ON).
+// Runs the same three stages through basic_pipeline with several batch sizes and through run_serial, printing the
+// throughput and the latency of each item from the first stage to the calling thread, for light and heavy stages.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "ctl/pipeline.h"
+#include "ctl/tuning.h"
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr std::size_t item_count = std::size_t{1} << 18;
+
+    struct item
+    {
+        std::uint64_t value;
+        clock_type::time_point start;
+    };
+
+    std::uint64_t mix(std::uint64_t x, std::size_t rounds) noexcept
+    {
+        for (std::size_t r = 0; r < rounds; ++r)
+            x = (x ^ (x >> 31)) * 0x9E3779B97F4A7C15ull;
+        return x;
+    }
+
+    // The first stage stamps each item, the others only do their share of the work.
+    template<std::size_t Rounds>
+    struct source
+    {
+        item operator()(std::uint64_t x) const noexcept
+        {
+            return item{mix(x, Rounds), clock_type::now()};
+        }
+    };
+
+    template<std::size_t Rounds>
+    struct work
+    {
+        item operator()(item x) const noexcept
+        {
+            x.value = mix(x.value, Rounds);
+            return x;
+        }
+    };
+
+    // Output iterator recording how long each item took to come out of the pipeline.
+    struct latency_recorder
+    {
+        std::vector<double> *latencies;
+        std::uint64_t *checksum;
+
+        latency_recorder &operator*() noexcept { return *this; }
+        latency_recorder &operator++(int) noexcept { return *this; }
+
+        latency_recorder &operator=(const item &x)
+        {
+            latencies->push_back(std::chrono::duration<double, std::nano>(clock_type::now() - x.start).count());
+            *checksum += x.value;
+            return *this;
+        }
+    };
+
+    std::vector<std::uint64_t> inputs(item_count);
+    std::uint64_t sink = 0;
+
+    template<typename Pipeline, bool Serial>
+    void measure(const char *name)
+    {
+        std::vector<double> latencies;
+        latencies.reserve(item_count);
+        double ns = ctl::measure_ns([&]
+        {
+            latencies.clear();
+            latency_recorder out{&latencies, &sink};
+            if constexpr (Serial)
+                Pipeline::run_serial(inputs.begin(), inputs.end(), out);
+            else
+                Pipeline::run(inputs.begin(), inputs.end(), out);
+        }, 5);
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << name << '\t' << item_count / ns * 1e3 << " M items/s\tlatency p50 "
+                  << latencies[latencies.size() / 2] << " ns, p99 " << latencies[latencies.size() * 99 / 100] << " ns\n";
+    }
+
+    template<std::size_t Rounds>
+    void compare()
+    {
+        std::cout << Rounds << " rounds per stage\n";
+        using stages = ctl::basic_pipeline<1024, 64, source<Rounds>, work<Rounds>, work<Rounds>>;
+        measure<stages, true>("  run_serial ");
+        measure<ctl::basic_pipeline<1024, 1, source<Rounds>, work<Rounds>, work<Rounds>>, false>("  batch 1    ");
+        measure<ctl::basic_pipeline<1024, 16, source<Rounds>, work<Rounds>, work<Rounds>>, false>("  batch 16   ");
+        measure<stages, false>("  batch 64   ");
+        measure<ctl::basic_pipeline<1024, 256, source<Rounds>, work<Rounds>, work<Rounds>>, false>("  batch 256  ");
+    }
+}
+
+int main()
+{
+    for (std::size_t i = 0; i < item_count; ++i)
+        inputs[i] = i;
+    // The stages only run in parallel with at least one hardware thread each.
+    std::cout << std::thread::hardware_concurrency() << " hardware threads\n";
+    compare<4>();
+    compare<256>();
+
+    // Keep the results observable so that the stages are not optimized away.
+    volatile std::uint64_t result = sink;
+    (void) result;
+}
@@ -0,0 +1,94 @@
+// Benchmark for ctl::poly (built with -DCTL_BUILD_BENCHMARKS=ON).
+// Evaluates the Taylor polynomials of exp of degree 3, 7 and 15 with Horner's and Estrin's schemes, and prints
+// the latency (each argument depends on the previous result) and the throughput (independent arguments),
+// for doubles and for vectors of two doubles.
+#include <cstdint>
+#include <iostream>
+#include <ratio>
+#include <utility>
+#include <vector>
+#include "ctl/poly.h"
+#include "ctl/tuning.h"
+
+namespace
+{
+    using double2 = double __attribute__((vector_size(16)));
+
+    constexpr std::size_t chain_length = 1 << 16;
+    constexpr std::size_t argument_count = 1 << 12;
+    constexpr std::size_t repetitions = 50;
+
+    constexpr std::intmax_t factorial(std::intmax_t k) noexcept
+    {
+        return k <= 1 ? 1 : k * factorial(k - 1);
+    }
+
+    template<typename Sequence>
+    struct exp_taylor;
+
+    template<std::size_t ... Ks>
+    struct exp_taylor<std::index_sequence<Ks ...>>
+    {
+        using type = ctl::poly<std::ratio<1, factorial(Ks)> ...>;
+    };
+
+    double sink = 0;
+
+    template<typename V>
+    double first_lane(const V &v)
+    {
+        if constexpr (std::is_arithmetic_v<V>)
+            return v;
+        else
+            return v[0];
+    }
+
+    template<typename Poly, ctl::poly_scheme Scheme, typename V>
+    void measure(const char *name, const char *type)
+    {
+        // Latency: the next argument is derived from the previous result, so evaluations cannot overlap.
+        double latency = ctl::measure_ns([]
+        {
+            V x = V{} + 0.001;
+            for (std::size_t i = 0; i < chain_length; ++i)
+                x = Poly::template evaluate<Scheme>(x) * 0.001;
+            sink += first_lane(x);
+        }, repetitions);
+
+        // Throughput: independent arguments, so the evaluations of consecutive elements overlap.
+        std::vector<V> arguments(argument_count);
+        for (std::size_t i = 0; i < argument_count; ++i)
+            arguments[i] = V{} + static_cast<double>(i) / argument_count - 0.5;
+        double throughput = ctl::measure_ns([&]
+        {
+            V sum{};
+            for (const V &x : arguments)
+                sum += Poly::template evaluate<Scheme>(x);
+            sink += first_lane(sum);
+        }, repetitions);
+
+        std::cout << "degree " << Poly::degree << '\t' << type << '\t' << name << "\tlatency "
+                  << latency / chain_length << " ns\tthroughput " << throughput / argument_count << " ns\n";
+    }
+
+    template<std::size_t Degree>
+    void compare()
+    {
+        using poly = typename exp_taylor<std::make_index_sequence<Degree + 1>>::type;
+        measure<poly, ctl::poly_scheme::horner, double>("horner", "double ");
+        measure<poly, ctl::poly_scheme::estrin, double>("estrin", "double ");
+        measure<poly, ctl::poly_scheme::horner, double2>("horner", "double2");
+        measure<poly, ctl::poly_scheme::estrin, double2>("estrin", "double2");
+    }
+}
+
+int main()
+{
+    compare<3>();
+    compare<7>();
+    compare<15>();
+
+    // Keep the results observable so that the evaluations are not optimized away.
+    volatile double result = sink;
+    (void) result;
+}
@@ -0,0 +1,81 @@
+// Benchmark for ctl::prefetch_for (built with -DCTL_BUILD_BENCHMARKS=ON).
+// Sweeps the prefetch distance over a gather through a shuffled index array on a working set larger than the caches,
+// and prints the time per element next to the plain loop, and for the loop unrolled over blocks of a compile-time size.
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "ctl/loops.h"
+#include "ctl/prefetch.h"
+#include "ctl/tuning.h"
+
+namespace
+{
+    // 64 bytes per element, so that every access touches its own cache line.
+    struct record
+    {
+        std::uint64_t key;
+        std::uint64_t payload[7];
+    };
+
+    constexpr std::size_t element_count = std::size_t{1} << 21;
+    constexpr std::size_t repetitions = 5;
+    constexpr std::size_t block = 256;
+
+    std::vector<record> records(element_count);
+    std::vector<std::uint32_t> indices(element_count);
+    std::uint64_t sink = 0;
+
+    void report(const char *name, double ns)
+    {
+        std::cout << name << '\t' << ns / element_count << " ns/element\n";
+    }
+
+    template<std::size_t Distance>
+    struct sweep
+    {
+        void operator()() const
+        {
+            double ns = ctl::measure_ns([]
+            {
+                std::uint64_t sum = 0;
+                ctl::prefetch_for<Distance>::begin_indirect(records.data(), indices.data(), element_count,
+                                                            [&](const record &r) { sum += r.key; });
+                sink += sum;
+            }, repetitions);
+            std::cout << "distance " << Distance << '\t' << ns / element_count << " ns/element\n";
+        }
+    };
+}
+
+int main()
+{
+    static_assert(element_count % block == 0, "the unrolled loop covers whole blocks");
+    for (std::size_t i = 0; i < element_count; ++i)
+        records[i].key = i;
+    std::iota(indices.begin(), indices.end(), 0u);
+    std::shuffle(indices.begin(), indices.end(), std::mt19937{42});
+
+    report("no prefetch", ctl::measure_ns([]
+    {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < element_count; ++i)
+            sum += records[indices[i]].key;
+        sink += sum;
+    }, repetitions));
+    ctl::for_each_value<std::size_t, 1, 2, 4, 8, 16, 32, 64, 128>::begin<sweep>();
+    report("unrolled, distance 16", ctl::measure_ns([]
+    {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < element_count; i += block)
+            ctl::prefetch_for<16>::begin_indirect_unrolled<block>(records.data(), indices.data() + i,
+                                                                  [&](const record &r) { sum += r.key; });
+        sink += sum;
+    }, repetitions));
+
+    // Keep the sums observable so that the loops are not optimized away.
+    volatile std::uint64_t result = sink;
+    (void) result;
+}
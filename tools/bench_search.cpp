@@ -0,0 +1,89 @@
+// Benchmark for ctl::static_lower_bound and ctl::eytzinger (built with -DCTL_BUILD_BENCHMARKS=ON).
+// Searches random keys in sorted constant tables of 8 to 4096 ints and prints the time per search next to
+// std::lower_bound, for independent searches and for a chain where each key depends on the previous result.
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "ctl/search.h"
+#include "ctl/tuning.h"
+
+namespace
+{
+    constexpr std::size_t key_count = 1 << 14;
+    constexpr std::size_t repetitions = 50;
+
+    template<std::size_t N>
+    constexpr std::array<int, N> make_table() noexcept
+    {
+        std::array<int, N> result{};
+        for (std::size_t i = 0; i < N; ++i)
+            result[i] = static_cast<int>(3 * i + 1);
+        return result;
+    }
+
+    std::size_t sink = 0;
+
+    template<typename Search>
+    void measure(const char *name, const std::vector<int> &keys, Search &&search)
+    {
+        double independent = ctl::measure_ns([&]
+        {
+            std::size_t sum = 0;
+            for (int key : keys)
+                sum += search(key);
+            sink += sum;
+        }, repetitions);
+        // Each key is offset by the previous result, so the next search cannot start before the last one ends.
+        double dependent = ctl::measure_ns([&]
+        {
+            std::size_t last = 0;
+            for (int key : keys)
+                last = search(key + static_cast<int>(last & 1));
+            sink += last;
+        }, repetitions);
+        std::cout << '\t' << name << independent / key_count << " / " << dependent / key_count << " ns";
+    }
+
+    template<std::size_t N>
+    void compare()
+    {
+        static constexpr std::array<int, N> table = make_table<N>();
+        static constexpr ctl::eytzinger<int, N> tree{table};
+
+        std::vector<int> keys(key_count);
+        std::mt19937 random{N};
+        std::uniform_int_distribution<int> distribution(0, static_cast<int>(3 * N + 1));
+        for (int &key : keys)
+            key = distribution(random);
+
+        std::cout << "N=" << N;
+        measure("std::lower_bound ", keys, [](int key)
+        {
+            return static_cast<std::size_t>(std::lower_bound(table.begin(), table.end(), key) - table.begin());
+        });
+        measure("static_lower_bound ", keys, [](int key) { return ctl::static_lower_bound<N>::find(table, key); });
+        measure("eytzinger ", keys, [](int key) { return tree.lower_bound(key); });
+        std::cout << '\n';
+    }
+}
+
+int main()
+{
+    std::cout << "time per search, independent / dependent\n";
+    compare<8>();
+    compare<16>();
+    compare<32>();
+    compare<64>();
+    compare<128>();
+    compare<256>();
+    compare<512>();
+    compare<1024>();
+    compare<2048>();
+    compare<4096>();
+
+    // Keep the results observable so that the searches are not optimized away.
+    volatile std::size_t result = sink;
+    (void) result;
+}